@@ -33,6 +33,19 @@
 static uint32_t arr_value;                 // 自动重装载值
 static uint32_t clock_freq;                // 定时器时钟频率
 static volatile uint32_t overflow_counter; // 溢出计数器
+static uint64_t tick_epoch;                // 时间线偏移, 运行时切换时钟后保持时间戳连续
+
+/**
+ * @brief 最近一次运行时切换时钟前的参数, 用于换算切换前初始化的句柄
+ */
+static struct
+{
+    uint32_t switch_ovf;  // 切换后的起始溢出计数, 句柄记录的溢出计数小于该值说明在切换前初始化
+    uint64_t old_period;  // 切换前的溢出周期(tick)
+    uint32_t old_freq;    // 切换前的时钟频率
+    uint64_t old_epoch;   // 切换前的时间线偏移
+    uint64_t snapshot;    // TimerLib_ClockChangeBegin记录的时间戳(切换前单位)
+} rebase;
 
 /**
  * @brief 优化参数缓存结构体
@@ -44,19 +57,185 @@ struct
     bool ns_optimized;      // 纳秒计算是否可优化
     uint32_t ns_per_tick;   // 每个tick对应的纳秒数
     uint32_t overflowPreMS; // 每毫秒溢出次数,用于微秒短延时优化
+    uint32_t spin_per_ns_q16;   // 每纳秒空循环次数(Q16), 0表示未校准
+    uint32_t spin_overhead_ns;  // 空循环调用的固定开销(纳秒)
+    uint32_t spin_crossover_ns; // 低于该值的纳秒延时使用空循环
+    uint32_t ticks_per_ns_q24;  // 每纳秒tick数(Q24, 向上取整), 用于统一延时入口的单位换算
+    bool arr_pow2;              // 溢出周期(ARR+1)是否为2的幂
+    uint32_t arr_shift;         // 溢出周期为2的幂时的位数
+    uint64_t freq_recip;        // floor((2^64-1)/clock_freq), 用于定点秒换算
 } optim;
 
-__attribute__((always_inline)) static inline uint32_t get_current_cnt(void)
+static void build_delay_table(void);
+
+/*
+ * 2的幂溢出周期路径选择: 定义 TIMERLIB_ARR_BITS (如16) 时在编译期固定为移位实现,
+ * 否则在 TimerLib_GlobalInit 中根据 arr 判断
+ */
+#ifdef TIMERLIB_ARR_BITS
+#define ARR_POW2 true
+#define ARR_SHIFT ((uint32_t)TIMERLIB_ARR_BITS)
+#else
+#define ARR_POW2 optim.arr_pow2
+#define ARR_SHIFT optim.arr_shift
+#endif
+
+__attribute__((always_inline)) static inline uint32_t read_hw_cnt(void)
 {
     // NOTE: 用户需替换为实际定时器访问 ==============================
     return LL_TIM_GetCounter(TIM1);
 }
 
-void TimerLib_GlobalInit(uint32_t arr, uint32_t clk_freq)
+/**
+ * @brief 连续读取直到两次读数一致, 用于计数时钟与内核时钟异步的定时器(如LPTIM)
+ * @note 读数稳定时只多一次读取; 每次不一致时以最新读数为基准继续比较
+ */
+__attribute__((always_inline)) static inline uint32_t read_stable(uint32_t (*read)(void))
+{
+    uint32_t prev;
+    uint32_t cnt = read();
+
+    do
+    {
+        prev = cnt;
+        cnt = read();
+    } while (cnt != prev);
+
+    return cnt;
+}
+
+__attribute__((always_inline)) static inline uint32_t get_current_cnt(void)
+{
+#ifdef TIMERLIB_ASYNC_READ
+    return read_stable(read_hw_cnt);
+#else
+    return read_hw_cnt();
+#endif
+}
+
+static inline void set_current_cnt(uint32_t cnt)
+{
+    // NOTE: 用户需替换为实际定时器访问 ==============================
+    LL_TIM_SetCounter(TIM1, cnt);
+}
+
+#ifndef TIMERLIB_CRITICAL_ENTER
+#define TIMERLIB_CRITICAL_ENTER(state) \
+    do                                 \
+    {                                  \
+        (state) = __get_PRIMASK();     \
+        __disable_irq();               \
+    } while (0)
+#define TIMERLIB_CRITICAL_EXIT(state) __set_PRIMASK(state)
+#endif
+
+#if defined(TIMERLIB_SOFT_OVERFLOW) || defined(TIMERLIB_REPETITION)
+/*
+ * 软件回绕跟踪: 读数小于上次读数即认为发生了一次回绕, 累加到 soft_wraps。
+ *   TIMERLIB_SOFT_OVERFLOW: 不使用溢出中断, 全部回绕由软件跟踪
+ *   TIMERLIB_REPETITION:    高级定时器的重复计数器使每N次回绕才产生一次更新中断,
+ *                           中断一次累加N次溢出, 两次中断之间的回绕由软件跟踪
+ * 两种模式都要求至少每个溢出周期读取一次, 由 TimerLib_SoftOverflowWatchdog 检查。
+ */
+#define TIMERLIB_SOFT_WRAPS
+
+static uint32_t soft_last_cnt;          // 上次读到的计数值
+static uint32_t soft_anchor;            // 上次读取时的溢出计数, 变化说明发生了更新中断
+static uint32_t soft_wraps;             // 自上次更新中断以来软件检测到的回绕次数
+static volatile uint32_t soft_read_age; // 距上次读取的tick数(由看门狗累加)
+static volatile bool soft_violated;     // 读取间隔超过溢出周期
+
+__attribute__((always_inline)) static inline void read_counter(uint32_t *ovf, uint32_t *cnt)
+{
+    uint32_t state, irq_ovf, wraps;
+
+    TIMERLIB_CRITICAL_ENTER(state);
+    *cnt = get_current_cnt();
+    irq_ovf = overflow_counter;
+
+    // 包括更新事件已发生但中断尚未执行的情况, 此时该次回绕先由软件计入
+    wraps = soft_wraps + (*cnt < soft_last_cnt);
+    if (irq_ovf != soft_anchor)
+    {
+        // 更新中断累加的溢出数中, 软件已经计入的部分从回绕数中扣除, 剩余的是中断之后的新回绕;
+        // 上次读取时已计入触发中断的回绕时, 本次读到的回绕不能丢弃
+        uint32_t credited = irq_ovf - soft_anchor;
+
+        wraps = (wraps > credited) ? wraps - credited : 0;
+        soft_anchor = irq_ovf;
+    }
+    soft_wraps = wraps;
+    soft_last_cnt = *cnt;
+    soft_read_age = 0;
+    *ovf = irq_ovf + soft_wraps;
+    TIMERLIB_CRITICAL_EXIT(state);
+}
+
+void TimerLib_SoftOverflowWatchdog(uint32_t elapsed_ticks)
+{
+    uint32_t limit = arr_value - 1; // ARR, 32位满量程时为UINT32_MAX
+    uint32_t age = soft_read_age + elapsed_ticks;
+    bool saturated = (age < soft_read_age);
+
+    // 累计值不小于实际间隔, 因此判断偏保守, 不会漏报; 累加溢出说明已超过2^32个tick
+    soft_read_age = saturated ? UINT32_MAX : age;
+    if (saturated || age > limit)
+    {
+        soft_violated = true;
+    }
+}
+
+bool TimerLib_SoftOverflowViolated(bool clear)
+{
+    bool violated = soft_violated;
+
+    if (clear)
+    {
+        soft_violated = false;
+    }
+    return violated;
+}
+#else
+__attribute__((always_inline)) static inline void read_counter(uint32_t *ovf, uint32_t *cnt)
+{
+    // 原子读取当前值
+    do
+    {
+        *ovf = overflow_counter;
+        *cnt = get_current_cnt();
+    } while (*ovf != overflow_counter);
+}
+#endif
+
+/**
+ * @brief 由溢出计数和计数值合成64位tick
+ */
+__attribute__((always_inline)) static inline uint64_t compose_ticks(uint32_t ovf, uint32_t cnt)
+{
+    if (ARR_POW2)
+    {
+        return ((uint64_t)ovf << ARR_SHIFT) | cnt;
+    }
+    return (uint64_t)ovf * arr_value + cnt;
+}
+
+/**
+ * @brief 根据ARR与时钟频率计算换算参数, 不影响溢出计数
+ */
+static void apply_clock(uint32_t arr, uint32_t clk_freq)
 {
-    arr_value = arr;
+    // 计数器从0计到arr，溢出周期为arr+1个tick; arr为0xFFFFFFFF时arr_value回绕为0,
+    // 此时走2^32的2的幂路径, 32位运算自然按2^32取模
+    arr_value = arr + 1;
     clock_freq = clk_freq;
-    overflow_counter = 0;
+
+    // 溢出周期为2的幂时，合成时间戳只需移位
+    optim.arr_pow2 = ((arr & (arr + 1)) == 0);
+    optim.arr_shift = 0;
+    while (optim.arr_pow2 && optim.arr_shift < 32 && ((uint64_t)1 << optim.arr_shift) != (uint64_t)arr + 1)
+    {
+        optim.arr_shift++;
+    }
 
     // 计算微秒计算是否可优化
     optim.us_optimized = (clk_freq % 1000000 == 0);
@@ -76,7 +255,29 @@ void TimerLib_GlobalInit(uint32_t arr, uint32_t clk_freq)
     }
 
     // 计算每毫秒溢出次数, 用于短延时优化
-    optim.overflowPreMS = clk_freq / arr_value / 1000;
+    optim.overflowPreMS = (uint32_t)(clk_freq / ((uint64_t)arr + 1) / 1000);
+
+    // 向上取整: 换算结果不小于 ns * clk_freq / 1e9, 延时只会略长不会偏短
+    optim.ticks_per_ns_q24 = (uint32_t)((((uint64_t)clk_freq << 24) + 999999999) / 1000000000);
+    optim.freq_recip = UINT64_MAX / clk_freq;
+    build_delay_table();
+}
+
+void TimerLib_GlobalInit(uint32_t arr, uint32_t clk_freq)
+{
+    overflow_counter = 0;
+    tick_epoch = 0;
+    rebase.switch_ovf = 0;
+    rebase.old_freq = 0;
+#ifdef TIMERLIB_SOFT_WRAPS
+    soft_last_cnt = 0;
+    soft_anchor = 0;
+    soft_wraps = 0;
+    soft_read_age = 0;
+    soft_violated = false;
+#endif
+
+    apply_clock(arr, clk_freq);
 }
 
 void TimerLib_InitHandle(TimerLib_Handle *htim)
@@ -84,72 +285,124 @@ void TimerLib_InitHandle(TimerLib_Handle *htim)
     uint32_t cnt, ovf;
 
     // 原子读取当前计数值
-    do
-    {
-        ovf = overflow_counter;
-        cnt = get_current_cnt();
-    } while (ovf != overflow_counter);
+    read_counter(&ovf, &cnt);
 
     // 初始化时间句柄
     htim->last_cnt = cnt;
     htim->last_overflow = ovf;
 }
 
+#ifdef TIMERLIB_REPETITION
+static uint32_t ovf_per_irq = 1; // 每次更新中断对应的溢出次数(RCR+1)
+
+void TimerLib_SetRepetition(uint32_t rcr)
+{
+    ovf_per_irq = rcr + 1;
+}
+
+inline void TimerLib_HandleUpdateIRQ(void)
+{
+    overflow_counter += ovf_per_irq;
+}
+#else
 inline void TimerLib_HandleUpdateIRQ(void)
 {
     overflow_counter++;
 }
+#endif
+
+/**
+ * @brief 按频率比例换算tick数, 避免64位乘法溢出
+ */
+static uint64_t rescale_ticks(uint64_t ticks, uint32_t from_freq, uint32_t to_freq)
+{
+    return ticks / from_freq * to_freq + ticks % from_freq * to_freq / from_freq;
+}
+
+__attribute__((noinline)) static uint32_t rebased_interval(TimerLib_Handle *htim, uint32_t ovf, uint32_t cnt)
+{
+    uint64_t last = rebase.old_epoch + (uint64_t)htim->last_overflow * rebase.old_period + htim->last_cnt;
+
+    last = rescale_ticks(last, rebase.old_freq, clock_freq);
+    return (uint32_t)(tick_epoch + compose_ticks(ovf, cnt) - last);
+}
 
 static inline uint32_t calculate_ticks(TimerLib_Handle *htim)
 {
-    register uint32_t current_cnt, current_ovf, delta_cnt, delta_ovf;
+    uint32_t current_cnt, current_ovf, delta;
 
     // 原子读取当前值
-    do
-    {
-        current_ovf = overflow_counter;
-        current_cnt = get_current_cnt();
-    } while (current_ovf != overflow_counter);
+    read_counter(&current_ovf, &current_cnt);
 
-    // 计算计数器差值
-    if (current_cnt >= htim->last_cnt)
+    if (__builtin_expect(rebase.old_freq != 0 && (int32_t)(htim->last_overflow - rebase.switch_ovf) < 0, 0))
     {
-        delta_cnt = current_cnt - htim->last_cnt;
-        delta_ovf = current_ovf - htim->last_overflow;
+        // 句柄在最近一次切换时钟前初始化, 按切换前的参数换算到当前时间线
+        delta = rebased_interval(htim, current_ovf, current_cnt);
+    }
+    else if (ARR_POW2 && ARR_SHIFT < 32)
+    {
+        // 2的幂: 合成32位tick后直接无符号相减，回绕由模运算自然处理
+        delta = ((current_ovf << (ARR_SHIFT & 31)) | current_cnt) -
+                ((htim->last_overflow << (ARR_SHIFT & 31)) | htim->last_cnt);
+    }
+    else if (ARR_POW2)
+    {
+        // 32位定时器: 溢出周期为2^32，溢出部分对32位结果无贡献
+        delta = current_cnt - htim->last_cnt;
     }
     else
     {
-        delta_cnt = (arr_value - htim->last_cnt) + current_cnt;
-        // 计算溢出次数差值
-        delta_ovf = current_ovf - htim->last_overflow - 1;
+        // 按2^32取模，计数值回绕时结果同样正确，无需分支
+        delta = (current_ovf - htim->last_overflow) * arr_value + current_cnt - htim->last_cnt;
     }
 
     // 更新记录值
     htim->last_cnt = current_cnt;
     htim->last_overflow = current_ovf;
 
-    return delta_ovf * (arr_value) + delta_cnt;
+    return delta;
 }
 
-static inline uint64_t calculate_Timestamp()
+__attribute__((always_inline)) static inline uint32_t pack16(uint32_t ovf, uint32_t cnt)
+{
+    return (ovf << 16) | (cnt & 0xFFFF);
+}
+
+void TimerLib_InitHandle16(TimerLib_Handle16 *htim)
 {
-    register uint32_t current_cnt;
-    register uint32_t current_ovf;
+    uint32_t cnt, ovf;
 
-    // 原子读取当前值
-    do
+    read_counter(&ovf, &cnt);
+    htim->packed = pack16(ovf, cnt);
+}
+
+uint32_t TimerLib_GetInterval16_ticks(TimerLib_Handle16 *htim)
+{
+    uint32_t cnt, ovf, now, delta;
+
+    read_counter(&ovf, &cnt);
+    now = pack16(ovf, cnt);
+
+    if (ARR_POW2 && ARR_SHIFT == 16)
+    {
+        // 溢出周期为65536时打包值即为32位tick，直接相减
+        delta = now - htim->packed;
+    }
+    else
     {
-        current_ovf = overflow_counter;
-        current_cnt = get_current_cnt();
-    } while (current_ovf != overflow_counter);
+        // 溢出计数按16位回绕相减
+        uint16_t delta_ovf = (uint16_t)((now >> 16) - (htim->packed >> 16));
 
-    // 计算时间戳
-    return (uint64_t)current_ovf * (arr_value) + current_cnt;
+        delta = (uint32_t)delta_ovf * arr_value + (now & 0xFFFF) - (htim->packed & 0xFFFF);
+    }
+
+    htim->packed = now;
+    return delta;
 }
 
-uint64_t TimerLib_GetTimestamp_us()
+uint32_t TimerLib_GetInterval16_us(TimerLib_Handle16 *htim)
 {
-    uint64_t ticks = calculate_Timestamp();
+    uint32_t ticks = TimerLib_GetInterval16_ticks(htim);
 
     if (optim.us_optimized)
     {
@@ -158,7 +411,166 @@ uint64_t TimerLib_GetTimestamp_us()
     return (uint64_t)ticks * 1000000 / clock_freq;
 }
 
-float TimerLib_GetTimestamp_sf()
+static inline uint64_t calculate_Timestamp()
+{
+    uint32_t current_cnt;
+    uint32_t current_ovf;
+
+    // 原子读取当前值
+    read_counter(&current_ovf, &current_cnt);
+
+    // 计算时间戳
+    return tick_epoch + compose_ticks(current_ovf, current_cnt);
+}
+
+void TimerLib_ClockChangeBegin(void)
+{
+    rebase.snapshot = calculate_Timestamp();
+}
+
+void TimerLib_ClockChangeEnd(uint32_t arr, uint32_t clk_freq)
+{
+    uint32_t state, ovf, cnt;
+
+    // 参数、溢出计数与时间线原点一起切换, 中断中读取时间戳不会看到新旧混合的状态
+    TIMERLIB_CRITICAL_ENTER(state);
+    rebase.old_period = (arr_value != 0) ? arr_value : ((uint64_t)1 << 32);
+
+    // 空循环的校准值随内核时钟变化而失效, 在重新校准之前纳秒延时全部走计数器轮询
+    optim.spin_per_ns_q16 = 0;
+    optim.spin_overhead_ns = 0;
+    optim.spin_crossover_ns = 0;
+    rebase.old_freq = clock_freq;
+    rebase.old_epoch = tick_epoch;
+
+    apply_clock(arr, clk_freq);
+
+    // 溢出计数跳过一个值, 使切换前初始化的句柄可以被识别
+    read_counter(&ovf, &cnt);
+    rebase.switch_ovf = ovf + 1;
+#ifdef TIMERLIB_SOFT_WRAPS
+    // 与休眠补偿相同, 自上次更新中断以来的回绕数保留在soft_wraps中, 合成的溢出计数仍为switch_ovf
+    overflow_counter = rebase.switch_ovf - soft_wraps;
+    soft_anchor = overflow_counter;
+    soft_last_cnt = cnt;
+#else
+    overflow_counter = rebase.switch_ovf;
+#endif
+
+    // 切换时刻在新时间线上的位置 = 切换前的时间戳换算到新频率
+    tick_epoch = rescale_ticks(rebase.snapshot, rebase.old_freq, clk_freq) - compose_ticks(rebase.switch_ovf, cnt);
+    TIMERLIB_CRITICAL_EXIT(state);
+}
+
+/**
+ * @brief 低功耗休眠期间保持计时的低速时钟
+ */
+static struct
+{
+    uint32_t (*read)(void); // 读取低速计数器
+    uint32_t freq;          // 低速时钟频率(Hz)
+    uint32_t mask;          // 低速计数器位宽掩码
+    uint32_t enter_slow;    // 进入休眠时的低速计数值
+    uint64_t enter_fast;    // 进入休眠时的原始tick
+    uint64_t last_sleep;    // 最近一次休眠丢失并补偿的tick数
+    uint64_t total_sleep;   // 累计补偿的tick数
+} slow_clock;
+
+/**
+ * @brief 等待低速时钟跳变, 返回跳变后的计数值与此刻的原始tick
+ */
+static uint32_t wait_slow_edge(uint64_t *fast)
+{
+    uint32_t ovf, cnt;
+    uint32_t first = read_stable(slow_clock.read);
+    uint32_t now;
+
+    // 低速计数器通常与内核时钟异步, 读数需经过滤, 否则撕裂的读数会被误判为跳变
+    do
+    {
+        now = read_stable(slow_clock.read);
+        read_counter(&ovf, &cnt);
+    } while (now == first);
+
+    *fast = compose_ticks(ovf, cnt);
+    return now;
+}
+
+void TimerLib_SlowClock_Config(uint32_t (*read)(void), uint32_t freq, uint32_t bits)
+{
+    slow_clock.read = read;
+    slow_clock.freq = freq;
+    slow_clock.mask = (bits >= 32) ? UINT32_MAX : (((uint32_t)1 << bits) - 1);
+    slow_clock.last_sleep = 0;
+    slow_clock.total_sleep = 0;
+}
+
+void TimerLib_SleepEnter(void)
+{
+    slow_clock.enter_slow = wait_slow_edge(&slow_clock.enter_fast);
+}
+
+uint64_t TimerLib_SleepExit(void)
+{
+    uint32_t state, ovf, cnt;
+    uint64_t fast, slept, counted, target;
+    uint32_t slow = wait_slow_edge(&fast);
+
+    // 两端都对齐到低速时钟跳变, 低速计数差即为精确的休眠时长; 减去快速定时器自身计到的部分即为丢失的tick
+    slept = rescale_ticks((slow - slow_clock.enter_slow) & slow_clock.mask, slow_clock.freq, clock_freq);
+    counted = fast - slow_clock.enter_fast;
+    slow_clock.last_sleep = (slept > counted) ? slept - counted : 0;
+    slow_clock.total_sleep += slow_clock.last_sleep;
+    if (slow_clock.last_sleep == 0)
+    {
+        return 0;
+    }
+
+    // 将丢失的时间补回快速定时器, 已初始化的句柄跨越休眠测得的间隔同样包含休眠时间
+    TIMERLIB_CRITICAL_ENTER(state);
+    read_counter(&ovf, &cnt);
+    target = compose_ticks(ovf, cnt) + slow_clock.last_sleep;
+    if (ARR_POW2)
+    {
+        ovf = (uint32_t)(target >> ARR_SHIFT);
+        cnt = (uint32_t)(target & (((uint64_t)1 << ARR_SHIFT) - 1));
+    }
+    else
+    {
+        ovf = (uint32_t)(target / arr_value);
+        cnt = (uint32_t)(target % arr_value);
+    }
+    set_current_cnt(cnt);
+#ifdef TIMERLIB_SOFT_WRAPS
+    // 写计数值不会复位重复计数器, 自上次更新中断以来的回绕数(soft_wraps)保留不变,
+    // 下一次中断累加RCR+1次溢出时恰好补齐剩余的回绕
+    overflow_counter = ovf - soft_wraps;
+    soft_anchor = overflow_counter;
+    soft_last_cnt = cnt;
+#else
+    overflow_counter = ovf;
+#endif
+    TIMERLIB_CRITICAL_EXIT(state);
+
+    return slow_clock.last_sleep;
+}
+
+uint64_t TimerLib_GetSleepTotal_tick(void)
+{
+    return slow_clock.total_sleep;
+}
+
+uint64_t TimerLib_GetTimestamp_tick(void)
+{
+    return calculate_Timestamp();
+}
+
+uint32_t TimerLib_GetClockFreq(void)
+{
+    return clock_freq;
+}
+
+uint64_t TimerLib_GetTimestamp_us()
 {
     uint64_t ticks = calculate_Timestamp();
 
@@ -166,18 +578,75 @@ float TimerLib_GetTimestamp_sf()
     {
         return ticks / optim.us_per_tick;
     }
-    return ticks / clock_freq * 1e-6f;
+    return (uint64_t)ticks * 1000000 / clock_freq;
+}
+
+float TimerLib_GetTimestamp_sf()
+{
+    return (float)TimerLib_GetTimestamp_q32() * (1.0f / 4294967296.0f);
 }
 
 double TimerLib_GetTimestamp_df()
 {
-    uint64_t ticks = calculate_Timestamp();
+    return (double)TimerLib_GetTimestamp_q32() * (1.0 / 4294967296.0);
+}
 
-    if (optim.us_optimized)
+/**
+ * @brief 64x64位乘积的高64位, 只使用32x32位乘法
+ */
+static uint64_t mul_hi64(uint64_t a, uint64_t b)
+{
+    uint64_t al = (uint32_t)a, ah = a >> 32;
+    uint64_t bl = (uint32_t)b, bh = b >> 32;
+    uint64_t ll = al * bl, lh = al * bh, hl = ah * bl, hh = ah * bh;
+    uint64_t mid = (ll >> 32) + (uint32_t)lh + (uint32_t)hl;
+
+    return hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+}
+
+uint64_t TimerLib_SplitSeconds(uint64_t ticks, uint32_t *rem_ticks)
+{
+    // 预先计算的倒数估计商(偏小), 由余数校正, 结果与整数除法一致
+    uint64_t q = mul_hi64(ticks, optim.freq_recip);
+    uint64_t r = ticks - q * clock_freq;
+
+    while (r >= clock_freq)
     {
-        return ticks / optim.us_per_tick * 1e-9;
+        q++;
+        r -= clock_freq;
     }
-    return ticks / clock_freq * 1e-9;
+    *rem_ticks = (uint32_t)r;
+    return q;
+}
+
+/**
+ * @brief tick数换算为Q32.32秒: 整秒与秒内小数分别求, 均为精确截断
+ */
+static uint64_t ticks_to_q32(uint64_t ticks)
+{
+    uint32_t rem;
+    uint64_t seconds = TimerLib_SplitSeconds(ticks, &rem);
+
+    // rem < clock_freq < 2^32, 左移32位后的"整秒数"即为秒内小数的Q32值
+    return (seconds << 32) | TimerLib_SplitSeconds((uint64_t)rem << 32, &rem);
+}
+
+uint64_t TimerLib_GetTimestamp_q32(void)
+{
+    return ticks_to_q32(calculate_Timestamp());
+}
+
+uint64_t TimerLib_GetInterval_q32(TimerLib_Handle *htim)
+{
+    return ticks_to_q32(calculate_ticks(htim));
+}
+
+uint32_t TimerLib_GetInterval_q16(TimerLib_Handle *htim)
+{
+    uint32_t rem;
+
+    // 间隔不超过2^32 tick, 时钟频率不低于65536Hz时结果不超过32位
+    return (uint32_t)TimerLib_SplitSeconds((uint64_t)calculate_ticks(htim) << 16, &rem);
 }
 
 uint32_t TimerLib_GetInterval_us(TimerLib_Handle *htim)
@@ -193,24 +662,17 @@ uint32_t TimerLib_GetInterval_us(TimerLib_Handle *htim)
 
 float TimerLib_GetInterval_sf(TimerLib_Handle *htim)
 {
-    uint32_t ticks = calculate_ticks(htim);
-
-    if (optim.us_optimized)
-    {
-        return ticks / optim.us_per_tick * 1e-6f;
-    }
-    return ticks / clock_freq * 1e-6f;
+    return (float)TimerLib_GetInterval_q32(htim) * (1.0f / 4294967296.0f);
 }
 
 double TimerLib_GetInterval_df(TimerLib_Handle *htim)
 {
-    uint32_t ticks = calculate_ticks(htim);
+    return (double)TimerLib_GetInterval_q32(htim) * (1.0 / 4294967296.0);
+}
 
-    if (optim.ns_optimized)
-    {
-        return ticks / optim.ns_per_tick * 1e-9;
-    }
-    return ticks / clock_freq * 1e-9;
+double TimerLib_GetInterval_sd(TimerLib_Handle *htim)
+{
+    return TimerLib_GetInterval_df(htim);
 }
 
 uint32_t TimerLib_GetInterval_ns(TimerLib_Handle *htim)
@@ -224,180 +686,345 @@ uint32_t TimerLib_GetInterval_ns(TimerLib_Handle *htim)
     return (uint64_t)ticks * 1000000000 / clock_freq;
 }
 
-void TimerLib_DelayNS(uint32_t ns)
+/**
+ * @brief 纯指令空循环, 不内联以保证每次调用的开销一致
+ */
+__attribute__((noinline)) static void spin_loop(uint32_t loops)
 {
-    uint32_t start_ovf, start_cnt;
-    do
+    while (loops--)
     {
-        start_ovf = overflow_counter;
-        start_cnt = get_current_cnt();
-    } while (start_ovf != overflow_counter);
-
-    // 在MCU上，基本看不到1G的定时器，所有直接计算所需的tick
-    const uint64_t delay_ticks = (uint64_t)ns * clock_freq / 1000000000;
+        __asm__ volatile("");
+    }
+}
 
-    uint32_t current_ovf, current_cnt;
-    uint64_t elapsed;
+/**
+ * @brief 测量执行loops次空循环所需的最短时间(tick)
+ */
+static uint32_t measure_spin(uint32_t loops)
+{
+    uint32_t best = UINT32_MAX;
 
-    // 等待时间到达
-    while (1)
+    for (int i = 0; i < 8; i++)
     {
-        // 原子读取当前值
-        do
-        {
-            current_ovf = overflow_counter;
-            current_cnt = get_current_cnt();
-        } while (current_ovf != overflow_counter);
+        uint64_t start = calculate_Timestamp();
+        spin_loop(loops);
+        uint32_t ticks = (uint32_t)(calculate_Timestamp() - start);
 
-        // 计算经过的tick数
-        if (current_ovf == start_ovf)
-        {
-            elapsed = current_cnt - start_cnt;
-        }
-        else
+        if (ticks < best)
         {
-            elapsed = (arr_value - start_cnt) +
-                      (current_ovf - start_ovf - 1) * (arr_value) +
-                      current_cnt;
+            best = ticks;
         }
-
-        if (elapsed >= delay_ticks)
-            break;
     }
+    return best;
 }
 
-void TimerLib_DelayUS(uint32_t us)
+void TimerLib_CalibrateSpin(void)
 {
-    uint32_t start_ovf, start_cnt, current_ovf, current_cnt;
-    uint64_t delay_ticks, elapsed;
+    uint32_t loops = 16;
+    uint32_t t1, t2, read_ticks;
+    uint64_t ns1, ns2, read_ns;
 
-    do
+    // 单次读时间戳的开销, 决定计数器轮询可达到的最小粒度
+    uint64_t start = calculate_Timestamp();
+    for (int i = 0; i < 16; i++)
     {
-        start_ovf = overflow_counter;
-        start_cnt = get_current_cnt();
-    } while (start_ovf != overflow_counter);
+        (void)calculate_Timestamp();
+    }
+    read_ticks = (uint32_t)(calculate_Timestamp() - start) / 17;
 
-    // 优化路径计算
-    if (optim.us_optimized)
+    // 循环次数倍增, 直到测量时长远大于读时间戳开销
+    while (loops < (1u << 24) && measure_spin(loops) < read_ticks * 64 + 64)
     {
-        delay_ticks = us * optim.us_per_tick;
+        loops <<= 1;
     }
-    else
+
+    // 两点校准: 斜率为每次循环耗时, 截距为调用开销
+    t1 = measure_spin(loops);
+    t2 = measure_spin(loops * 2);
+    ns1 = (uint64_t)t1 * 1000000000 / clock_freq;
+    ns2 = (uint64_t)t2 * 1000000000 / clock_freq;
+    if (ns2 <= ns1)
     {
-        delay_ticks = (uint64_t)us * clock_freq / 1000000;
+        optim.spin_per_ns_q16 = 0;
+        optim.spin_crossover_ns = 0;
+        return;
+    }
+
+    optim.spin_per_ns_q16 = (uint32_t)(((uint64_t)loops << 16) / (ns2 - ns1));
+
+    // 截距包含一次读时间戳的开销, 扣除后为空循环调用本身的开销
+    read_ns = (uint64_t)read_ticks * 1000000000 / clock_freq;
+    ns1 = (ns1 > ns2 - ns1) ? (ns1 - (ns2 - ns1)) : 0;
+    optim.spin_overhead_ns = (ns1 > read_ns) ? (uint32_t)(ns1 - read_ns) : 0;
+    // 空循环调用本身只有几条指令, 截距超过一次读时间戳的开销说明两点测量受到干扰
+    // (中断、内核频率变化), 此时开销被高估, 空循环范围内的延时会整体偏短
+    if (optim.spin_overhead_ns > read_ns)
+    {
+        optim.spin_overhead_ns = (uint32_t)read_ns;
+    }
+
+    // 轮询至少需要起止两次读取加若干次循环读取, 低于该时长时空循环更准确
+    optim.spin_crossover_ns = (uint32_t)((uint64_t)read_ticks * 4 * 1000000000 / clock_freq);
+
+    build_delay_table();
+}
+
+uint32_t TimerLib_GetSpinLimit_ns(void)
+{
+    return optim.spin_crossover_ns;
+}
+
+static void delay_spin(uint32_t ns)
+{
+    if (ns > optim.spin_overhead_ns)
+    {
+        spin_loop((uint32_t)(((uint64_t)(ns - optim.spin_overhead_ns) * optim.spin_per_ns_q16) >> 16));
     }
+}
+
+/**
+ * @brief 延时引擎: 以起始时刻加延时tick数作为绝对目标, 循环中只比较合成后的当前tick
+ * @note 溢出周期为2的幂且延时小于2^31 tick时，用32位模运算比较，无需处理回绕分支
+ */
+__attribute__((always_inline)) static inline void delay_from(uint64_t start, uint64_t delay_ticks)
+{
+    uint32_t ovf, cnt;
 
-    while (1)
+    if (ARR_POW2 && ARR_SHIFT < 32 && delay_ticks < 0x80000000u)
     {
-        // 原子读取当前值
+        const uint32_t shift = ARR_SHIFT & 31;
+        const uint32_t target = (uint32_t)start + (uint32_t)delay_ticks;
+
         do
         {
-            current_ovf = overflow_counter;
-            current_cnt = get_current_cnt();
-        } while (current_ovf != overflow_counter);
+            read_counter(&ovf, &cnt);
+        } while ((int32_t)(((ovf << shift) | cnt) - target) < 0);
+    }
+    else
+    {
+        const uint64_t target = start + delay_ticks;
 
-        // 计算经过的tick数
-        if (current_ovf == start_ovf)
-        {
-            elapsed = current_cnt - start_cnt;
-        }
-        else
+        do
         {
-            // 计算溢出次数差值
-            elapsed = (arr_value - start_cnt) +
-                      (current_ovf - start_ovf - 1) * (arr_value) +
-                      current_cnt;
-        }
-
-        if (elapsed >= delay_ticks)
-            break;
+            read_counter(&ovf, &cnt);
+        } while (compose_ticks(ovf, cnt) < target);
     }
 }
 
-void TimerLib_DelayUS_32(uint32_t us)
+__attribute__((always_inline)) static inline uint64_t read_ticks(void)
 {
-    uint32_t start_ovf, start_cnt, current_ovf, current_cnt, elapsed, delay_ticks;
-    do
+    uint32_t ovf, cnt;
+
+    read_counter(&ovf, &cnt);
+    return compose_ticks(ovf, cnt);
+}
+
+void TimerLib_DelayNS(uint32_t ns)
+{
+    if (ns < optim.spin_crossover_ns)
     {
-        start_ovf = overflow_counter;
-        start_cnt = get_current_cnt();
-    } while (start_ovf != overflow_counter);
+        delay_spin(ns);
+        return;
+    }
+
+    uint64_t start = read_ticks();
+
+    // 在MCU上，基本看不到1G的定时器，所有直接计算所需的tick
+    delay_from(start, (uint64_t)ns * clock_freq / 1000000000);
+}
+
+void TimerLib_DelayUS(uint32_t us)
+{
+    uint64_t start = read_ticks();
+    uint64_t delay_ticks;
 
     // 优化路径计算
     if (optim.us_optimized)
     {
-        delay_ticks = us * optim.us_per_tick;
+        delay_ticks = (uint64_t)us * optim.us_per_tick;
     }
     else
     {
-        delay_ticks = us * clock_freq / 1000000;
+        delay_ticks = (uint64_t)us * clock_freq / 1000000;
     }
 
-    while (1)
-    {
-        // 原子读取当前值
-        do
-        {
-            current_ovf = overflow_counter;
-            current_cnt = get_current_cnt();
-        } while (current_ovf != overflow_counter);
+    delay_from(start, delay_ticks);
+}
 
-        // 计算经过的tick数
-        if (current_ovf == start_ovf)
-        {
-            elapsed = current_cnt - start_cnt;
-        }
-        else
-        {
-            elapsed = (arr_value - start_cnt) +
-                      (current_ovf - start_ovf - 1) * (arr_value) +
-                      current_cnt;
-        }
+void TimerLib_DelayUntil_tick(uint64_t tick)
+{
+    uint32_t ovf, cnt;
 
-        if (elapsed >= delay_ticks)
-            break;
-    }
+    // 目标为时间线上的时刻, 须在时间线上比较: 换算成原始tick在时钟切换后
+    // 可能回绕(早于纪元起点的目标会变成极大值而永远等不到)
+    do
+    {
+        read_counter(&ovf, &cnt);
+    } while (tick_epoch + compose_ticks(ovf, cnt) < tick);
 }
 
-int TimerLib_DelayUS_32Short(uint32_t us)
+void TimerLib_DelayUS_32(uint32_t us)
 {
-    uint32_t start_ovf, start_cnt, current_ovf, current_cnt, elapsed, delay_ticks;
+    uint64_t start = read_ticks();
+    uint32_t delay_ticks;
 
-    do
+    // 优化路径计算
+    if (optim.us_optimized)
     {
-        start_ovf = overflow_counter;
-        start_cnt = get_current_cnt();
-    } while (start_ovf != overflow_counter);
+        delay_ticks = us * optim.us_per_tick;
+    }
+    else
+    {
+        // us*clock_freq在us > 59(72MHz)时即超过32位, 乘积须用64位计算
+        delay_ticks = (uint32_t)((uint64_t)us * clock_freq / 1000000);
+    }
+
+    delay_from(start, delay_ticks);
+}
 
+int TimerLib_DelayUS_32Short(uint32_t us)
+{
     // 优化路径计算
     if (!(optim.us_optimized && us < 1000 && optim.overflowPreMS <= 1))
     {
         return -1;
     }
 
-    delay_ticks = us * optim.us_per_tick;
+    delay_from(read_ticks(), us * optim.us_per_tick);
+    return 0;
+}
+
+/* 统一延时入口 ================================================================ */
 
-    while (1)
+/**
+ * @brief 延时策略表项, 按max_ns升序排列
+ */
+typedef struct
+{
+    uint32_t max_ns;         // 该策略适用的延时上限(不含)
+    void (*fn)(uint32_t ns); // 策略实现
+} DelayStrategy;
+
+#define DELAY_STRATEGY_COUNT 4
+
+static DelayStrategy delay_table[DELAY_STRATEGY_COUNT];
+static void (*idle_hook)(void);
+
+static inline uint32_t ns_to_ticks(uint32_t ns)
+{
+    return (uint32_t)(((uint64_t)ns * optim.ticks_per_ns_q24) >> 24);
+}
+
+/**
+ * @brief 64位通用延时
+ */
+static void delay_general(uint32_t ns)
+{
+    uint64_t start = read_ticks();
+
+    delay_from(start, ns_to_ticks(ns));
+}
+
+#ifndef TIMERLIB_SOFT_WRAPS
+/**
+ * @brief 32位短延时: 延时不超过一个溢出周期, 只轮询计数值, 不读溢出计数也不进临界区
+ * @note 轮询被抢占超过(溢出周期-延时)时会错过一次回绕, 延时多出一个溢出周期, 但不会偏短
+ */
+static void delay_short32(uint32_t ns)
+{
+    const uint32_t ticks = ns_to_ticks(ns);
+    const uint32_t start = get_current_cnt();
+    uint32_t cnt, elapsed;
+
+    // 换算向上取整, 紧贴溢出周期的请求可能达到一个周期, 计数值差无法表示
+    if (arr_value != 0 && ticks >= arr_value)
     {
-        // 原子读取当前值
-        do
-        {
-            current_ovf = overflow_counter;
-            current_cnt = get_current_cnt();
-        } while (current_ovf != overflow_counter);
+        delay_general(ns);
+        return;
+    }
 
-        // 计算经过的tick数
-        if (current_ovf > start_ovf)
-        {
-            elapsed = (arr_value - start_cnt) + current_cnt;
-        }
-        else
+    do
+    {
+        cnt = get_current_cnt();
+        elapsed = cnt - start;
+        if (cnt < start)
         {
-            elapsed = current_cnt - start_cnt;
+            // 回绕一次; arr_value为0时溢出周期为2^32, 32位减法本身已经取模
+            elapsed += arr_value;
         }
+    } while (elapsed < ticks);
+}
+#endif
+
+/**
+ * @brief 休眠+轮询: 在距离目标超过一个溢出周期时调用空闲钩子(如__WFI),
+ *        溢出中断保证至少每个溢出周期唤醒一次, 最后一段轮询计数器
+ */
+static void delay_sleep(uint32_t ns)
+{
+    // 目标交给TimerLib_DelayUntil_tick, 必须取时间线上的值(含tick_epoch)
+    uint64_t target = calculate_Timestamp() + ns_to_ticks(ns);
+    uint64_t period = (arr_value != 0) ? arr_value : ((uint64_t)1 << 32);
 
-        if (elapsed >= delay_ticks)
-            break;
+    while (calculate_Timestamp() + period < target)
+    {
+        idle_hook();
     }
-    return 0;
+    TimerLib_DelayUntil_tick(target);
+}
+
+static void build_delay_table(void)
+{
+    uint32_t i = 0;
+    uint64_t period = (arr_value != 0) ? arr_value : ((uint64_t)1 << 32);
+    uint64_t period_ns = (clock_freq != 0) ? period * 1000000000 / clock_freq : 0;
+
+    if (optim.spin_crossover_ns != 0)
+    {
+        delay_table[i].max_ns = optim.spin_crossover_ns;
+        delay_table[i++].fn = delay_spin;
+    }
+#ifndef TIMERLIB_SOFT_WRAPS
+    // 软件回绕检测依赖每个溢出周期至少一次read_counter, 只轮询计数值的短延时会漏记回绕
+    if (period_ns != 0)
+    {
+        delay_table[i].max_ns = (period_ns < UINT32_MAX) ? (uint32_t)period_ns : UINT32_MAX;
+        delay_table[i++].fn = delay_short32;
+    }
+#endif
+    if (idle_hook != 0 && period_ns * 2 < UINT32_MAX)
+    {
+        delay_table[i].max_ns = (uint32_t)(period_ns * 2);
+        delay_table[i++].fn = delay_general;
+        delay_table[i].max_ns = UINT32_MAX;
+        delay_table[i++].fn = delay_sleep;
+    }
+    else
+    {
+        delay_table[i].max_ns = UINT32_MAX;
+        delay_table[i++].fn = delay_general;
+    }
+
+    // 未使用的表项沿用最后一个策略
+    for (; i < DELAY_STRATEGY_COUNT; i++)
+    {
+        delay_table[i] = delay_table[i - 1];
+    }
+}
+
+void TimerLib_SetIdleHook(void (*hook)(void))
+{
+    idle_hook = hook;
+    build_delay_table();
+}
+
+void TimerLib_Delay_ns(uint32_t ns)
+{
+    const DelayStrategy *s = delay_table;
+
+    while (s < &delay_table[DELAY_STRATEGY_COUNT - 1] && ns >= s->max_ns)
+    {
+        s++;
+    }
+    s->fn(ns);
 }
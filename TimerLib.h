@@ -35,6 +35,14 @@ typedef struct {
     uint32_t last_overflow; // 上次溢出计数
 } TimerLib_Handle;
 
+/**
+ * @brief 16位定时器紧凑句柄，溢出计数低16位与计数值打包在一个32位字中
+ * @note 仅适用于溢出周期不超过65536的定时器，可测量的间隔不超过65536个溢出周期
+ */
+typedef struct {
+    uint32_t packed; // 高16位: 溢出计数低16位, 低16位: 计数器值
+} TimerLib_Handle16;
+
 /**
  * @brief 初始化定时器库全局参数
  * @param arr 自动重装载值
@@ -42,6 +50,49 @@ typedef struct {
  */
 void TimerLib_GlobalInit(uint32_t arr, uint32_t clk_freq);
 
+/**
+ * @brief 运行时切换时钟第一步: 记录当前时间戳，在修改定时器预分频/ARR之前调用
+ */
+void TimerLib_ClockChangeBegin(void);
+
+/**
+ * @brief 运行时切换时钟第二步: 在定时器写入新配置之后、重新启动之前调用，时间戳保持单调连续
+ * @param arr 新的自动重装载值
+ * @param clk_freq 新的定时器时钟频率(Hz)
+ * @note 两步之间定时器停止的时间不计入时间戳；最近一次切换前初始化的TimerLib_Handle
+ *       仍可正确计算间隔，更早的句柄以及16位紧凑句柄需要重新初始化
+ * @note TIMERLIB_REPETITION模式下重复计数器的相位沿用切换前的值，重新配置时不应产生更新事件(UG)
+ * @note 空循环延时的校准结果被清除，需要时在切换后重新调用TimerLib_CalibrateSpin
+ */
+void TimerLib_ClockChangeEnd(uint32_t arr, uint32_t clk_freq);
+
+/**
+ * @brief 配置低功耗休眠期间保持计时的低速时钟(LPTIM/RTC等)
+ * @param read 读取低速计数器的函数
+ * @param freq 低速时钟频率(Hz)
+ * @param bits 低速计数器位宽
+ * @note 单次休眠时长需小于低速计数器的一个回绕周期
+ */
+void TimerLib_SlowClock_Config(uint32_t (*read)(void), uint32_t freq, uint32_t bits);
+
+/**
+ * @brief 进入休眠前调用，对齐到低速时钟跳变并记录两个时钟的读数
+ */
+void TimerLib_SleepEnter(void);
+
+/**
+ * @brief 唤醒并重新启动定时器后调用，按低速时钟补偿休眠期间丢失的tick
+ * @return 本次补偿的tick数
+ * @note 会改写定时器计数值，补偿后时间戳与句柄间隔均包含休眠时间
+ */
+uint64_t TimerLib_SleepExit(void);
+
+/**
+ * @brief 获取累计补偿的休眠时间
+ * @return 累计tick数
+ */
+uint64_t TimerLib_GetSleepTotal_tick(void);
+
 /**
  * @brief 初始化时间句柄
  * @param htim 定时器句柄指针
@@ -53,6 +104,27 @@ void TimerLib_InitHandle(TimerLib_Handle *htim);
  */
 void TimerLib_HandleUpdateIRQ(void);
 
+/**
+ * @brief 设置高级定时器重复计数器的值(仅TIMERLIB_REPETITION模式)
+ * @param rcr 重复计数器寄存器值，每rcr+1次溢出产生一次更新中断
+ * @note 应在启动定时器前、与硬件RCR寄存器同时设置；要求读取计数器的间隔始终小于一个溢出周期(ARR+1个tick)
+ */
+void TimerLib_SetRepetition(uint32_t rcr);
+
+/**
+ * @brief 软件扩展计数器看门狗(仅TIMERLIB_SOFT_OVERFLOW/TIMERLIB_REPETITION模式)，在周期性上下文中调用
+ * @param elapsed_ticks 距上次调用经过的定时器tick数(如1ms SysTick对应clk_freq/1000)
+ * @note 距上次读取计数器的时间可能达到一个溢出周期时置位违例标志，判断偏保守
+ */
+void TimerLib_SoftOverflowWatchdog(uint32_t elapsed_ticks);
+
+/**
+ * @brief 查询读取间隔是否违反软件扩展计数器的要求(仅TIMERLIB_SOFT_OVERFLOW/TIMERLIB_REPETITION模式)
+ * @param clear 是否同时清除违例标志
+ * @return true表示曾出现读取间隔超过溢出周期，期间的回绕可能丢失
+ */
+bool TimerLib_SoftOverflowViolated(bool clear);
+
 /**
  * @brief 获取时间间隔(秒)，单精度浮点型返回
  * @param htim 定时器句柄指针
@@ -65,8 +137,29 @@ float TimerLib_GetInterval_sf(TimerLib_Handle *htim);
  * @param htim 定时器句柄指针
  * @return 自上次调用以来的时间间隔(秒)
  */
+double TimerLib_GetInterval_df(TimerLib_Handle *htim);
+
+/**
+ * @brief 同TimerLib_GetInterval_df，保留旧名称
+ */
 double TimerLib_GetInterval_sd(TimerLib_Handle *htim);
 
+/**
+ * @brief 获取时间间隔(秒)，Q32.32定点数返回
+ * @param htim 定时器句柄指针
+ * @return 自上次调用以来的时间间隔(秒, 低32位为小数部分)
+ * @note 结果等于 ticks*2^32/clk_freq 的截断值，只用乘法计算
+ */
+uint64_t TimerLib_GetInterval_q32(TimerLib_Handle *htim);
+
+/**
+ * @brief 获取时间间隔(秒)，Q16.16定点数返回
+ * @param htim 定时器句柄指针
+ * @return 自上次调用以来的时间间隔(秒, 低16位为小数部分)
+ * @note 时钟频率低于65536Hz时长间隔会溢出
+ */
+uint32_t TimerLib_GetInterval_q16(TimerLib_Handle *htim);
+
 /**
  * @brief 获取时间间隔(微秒)
  * @param htim 定时器句柄指针
@@ -81,6 +174,26 @@ uint32_t TimerLib_GetInterval_us(TimerLib_Handle *htim);
  */
 uint32_t TimerLib_GetInterval_ns(TimerLib_Handle *htim);
 
+/**
+ * @brief 初始化16位紧凑句柄
+ * @param htim 紧凑句柄指针
+ */
+void TimerLib_InitHandle16(TimerLib_Handle16 *htim);
+
+/**
+ * @brief 获取时间间隔(tick)，使用16位紧凑句柄
+ * @param htim 紧凑句柄指针
+ * @return 自上次调用以来的时间间隔(tick)
+ */
+uint32_t TimerLib_GetInterval16_ticks(TimerLib_Handle16 *htim);
+
+/**
+ * @brief 获取时间间隔(微秒)，使用16位紧凑句柄
+ * @param htim 紧凑句柄指针
+ * @return 自上次调用以来的时间间隔(微秒)
+ */
+uint32_t TimerLib_GetInterval16_us(TimerLib_Handle16 *htim);
+
 /**
  * @brief 获取当前时间戳(微秒)
  * @return 当前时间戳(微秒)
@@ -99,6 +212,46 @@ float TimerLib_GetTimestamp_sf();
  */
 double TimerLib_GetTimestamp_df();
 
+/**
+ * @brief 获取当前时间戳(秒)，Q32.32定点数返回
+ * @return 当前时间戳(秒, 低32位为小数部分)
+ */
+uint64_t TimerLib_GetTimestamp_q32(void);
+
+/**
+ * @brief 将tick数拆分为整秒与不足一秒的剩余tick
+ * @param ticks tick数
+ * @param rem_ticks 输出剩余tick数(小于时钟频率)
+ * @return 整秒数
+ * @note 用预先计算的时钟频率倒数做乘法并由余数校正，结果与整数除法完全一致，不调用64位除法
+ */
+uint64_t TimerLib_SplitSeconds(uint64_t ticks, uint32_t *rem_ticks);
+
+/**
+ * @brief 获取当前时间戳(原始tick)
+ * @return 当前时间戳(定时器tick数)
+ */
+uint64_t TimerLib_GetTimestamp_tick(void);
+
+/**
+ * @brief 获取定时器时钟频率
+ * @return 定时器时钟频率(Hz)
+ */
+uint32_t TimerLib_GetClockFreq(void);
+
+/**
+ * @brief 校准空循环延时，需在定时器启动后调用一次
+ * @note 校准后，短于计数器轮询粒度的纳秒延时改用空循环实现
+ * @note TimerLib_ClockChangeEnd会清除校准结果，切换时钟后需重新调用
+ */
+void TimerLib_CalibrateSpin(void);
+
+/**
+ * @brief 获取使用空循环实现的纳秒延时上限
+ * @return 短于该值的纳秒延时使用空循环，0表示未校准或校准失败
+ */
+uint32_t TimerLib_GetSpinLimit_ns(void);
+
 /**
  * @brief 纳秒级延时函数
  * @param ns 延时时间(纳秒)
@@ -111,9 +264,64 @@ void TimerLib_DelayNS(uint32_t ns);
  */
 void TimerLib_DelayUS(uint32_t us);
 
+/**
+ * @brief 微秒级延时函数(延时tick数按32位计算)
+ * @param us 延时时间(微秒)
+ * @note 要求us*clk_freq/1e6 < 2^32(72MHz下约59.6秒)，超出时tick数回绕、延时偏短；更长的延时使用TimerLib_DelayUS
+ */
+void TimerLib_DelayUS_32(uint32_t us);
+
+/**
+ * @brief 延时到指定的绝对时刻
+ * @param tick 目标时间戳(定时器tick数)，已经过去时立即返回
+ */
+void TimerLib_DelayUntil_tick(uint64_t tick);
+
 /**
  * @brief 微秒级短延时函数(仅适用于较短延时)
  * @param us 延时时间(微秒)
  * @return 0表示成功，-1表示参数不适合短延时
  */
 int TimerLib_DelayUS_32Short(uint32_t us);
+
+/**
+ * @brief 设置长延时使用的空闲钩子
+ * @param hook 空闲钩子(如执行__WFI)，NULL表示不休眠
+ * @note 钩子返回前必须能被定时器溢出中断唤醒
+ */
+void TimerLib_SetIdleHook(void (*hook)(void));
+
+/**
+ * @brief 统一延时入口，按延时长度选择开销最小的实现
+ * @param ns 延时时间(纳秒)
+ * @note 策略表在TimerLib_GlobalInit、TimerLib_CalibrateSpin和TimerLib_SetIdleHook时建立:
+ *       校准空循环 / 32位短延时(不超过一个溢出周期, 只轮询计数值) / 64位通用延时 / 休眠+轮询
+ * @note 定义TIMERLIB_SOFT_OVERFLOW或TIMERLIB_REPETITION时不使用32位短延时,
+ *       软件回绕检测需要延时期间经由完整读取路径轮询
+ */
+void TimerLib_Delay_ns(uint32_t ns);
+
+/**
+ * @brief 统一延时入口的内联版本，参数为编译期常量时在编译期完成单位换算
+ * @param ns 延时时间(纳秒)
+ */
+__attribute__((always_inline)) static inline void TimerLib_Delay(uint32_t ns)
+{
+    if (__builtin_constant_p(ns) && ns < 1000)
+    {
+        // 亚微秒延时直接进入纳秒延时，由其选择空循环或轮询
+        TimerLib_DelayNS(ns);
+    }
+    else if (__builtin_constant_p(ns) && ns % 1000 == 0 && ns / 1000 < 1000)
+    {
+        // 微秒整数倍的短延时优先尝试32位短延时，不满足条件时回退
+        if (TimerLib_DelayUS_32Short(ns / 1000) != 0)
+        {
+            TimerLib_Delay_ns(ns);
+        }
+    }
+    else
+    {
+        TimerLib_Delay_ns(ns);
+    }
+}
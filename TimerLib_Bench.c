@@ -0,0 +1,577 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file TimerLib_Bench.c
+ * @brief 基于TimerLib的微基准测试框架
+ * @note 仅使用整数运算，目标板与主机上行为一致
+ */
+#include "TimerLib_Bench.h"
+#include "TimerLib_Format.h"
+#include <string.h>
+
+static void bench_nop(void *ctx)
+{
+    (void)ctx;
+    __asm__ volatile("" ::: "memory");
+}
+
+static uint32_t measure(TimerLib_BenchFunc fn, void *ctx, uint32_t iterations)
+{
+    uint64_t start, end;
+
+    start = TimerLib_GetTimestamp_tick();
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        fn(ctx);
+    }
+    end = TimerLib_GetTimestamp_tick();
+
+    return (uint32_t)(end - start);
+}
+
+static void sort_samples(uint32_t *buf, uint32_t n)
+{
+    // 样本数很少，插入排序即可
+    for (uint32_t i = 1; i < n; i++)
+    {
+        uint32_t v = buf[i];
+        uint32_t j = i;
+
+        while (j > 0 && buf[j - 1] > v)
+        {
+            buf[j] = buf[j - 1];
+            j--;
+        }
+        buf[j] = v;
+    }
+}
+
+static uint32_t isqrt(uint32_t v)
+{
+    uint32_t r = 0;
+    uint32_t bit = 1u << 30;
+
+    while (bit > v)
+    {
+        bit >>= 2;
+    }
+    while (bit != 0)
+    {
+        if (v >= r + bit)
+        {
+            v -= r + bit;
+            r = (r >> 1) + bit;
+        }
+        else
+        {
+            r >>= 1;
+        }
+        bit >>= 2;
+    }
+    return r;
+}
+
+static uint64_t ticks_to_ps(uint32_t ticks, uint32_t iterations)
+{
+    // ticks * 1e9 不会溢出64位，先换算为总纳秒再均摊到每次调用
+    uint64_t ns = (uint64_t)ticks * 1000000000 / TimerLib_GetClockFreq();
+
+    return ns * 1000 / iterations;
+}
+
+void TimerLib_Bench_DefaultConfig(TimerLib_BenchConfig *cfg, uint32_t *buf, uint32_t capacity)
+{
+    cfg->buf = buf;
+    cfg->samples = capacity;
+    cfg->warmup = 16;
+    cfg->min_sample_ticks = 0;
+}
+
+int TimerLib_Bench_Run(const TimerLib_BenchConfig *cfg, TimerLib_BenchFunc fn, void *ctx,
+                       TimerLib_BenchResult *res)
+{
+    uint32_t *sample_buf = cfg->buf;
+    uint32_t n = cfg->samples;
+    uint32_t iterations, min_ticks, overhead, lo, hi, q1, q3, fence, half, first;
+
+    if (sample_buf == 0 || n < 4 || TimerLib_GetClockFreq() == 0)
+    {
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < cfg->warmup; i++)
+    {
+        fn(ctx);
+    }
+
+    // 自动样本时长: 至少为单次读时间戳开销的100倍
+    min_ticks = cfg->min_sample_ticks;
+    if (min_ticks == 0)
+    {
+        min_ticks = measure(bench_nop, 0, 1) * 100;
+        if (min_ticks < 1000)
+        {
+            min_ticks = 1000;
+        }
+    }
+
+    // 标定迭代次数，使每个样本足够长以淹没计时分辨率
+    iterations = 1;
+    while (iterations < (1u << 30) && measure(fn, ctx, iterations) < min_ticks)
+    {
+        iterations <<= 1;
+    }
+
+    // 以相同迭代次数测量空函数，取中位数作为开销
+    for (uint32_t i = 0; i < n; i++)
+    {
+        sample_buf[i] = measure(bench_nop, 0, iterations);
+    }
+    sort_samples(sample_buf, n);
+    overhead = sample_buf[n / 2];
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        uint32_t t = measure(fn, ctx, iterations);
+
+        sample_buf[i] = (t > overhead) ? (t - overhead) : 0;
+    }
+    sort_samples(sample_buf, n);
+
+    // Tukey围栏剔除离群值
+    q1 = sample_buf[n / 4];
+    q3 = sample_buf[(n * 3) / 4];
+    fence = (q3 - q1) + (q3 - q1) / 2;
+    lo = (q1 > fence) ? (q1 - fence) : 0;
+    hi = (q3 + fence >= q3) ? (q3 + fence) : UINT32_MAX;
+
+    first = 0;
+    while (first < n && sample_buf[first] < lo)
+    {
+        first++;
+    }
+    while (n > first && sample_buf[n - 1] > hi)
+    {
+        n--;
+    }
+
+    res->iterations = iterations;
+    res->overhead_ticks = overhead;
+    res->rejected = cfg->samples - (n - first);
+    res->samples = n - first;
+
+    // 中位数的非参数95%置信区间: 秩 n/2 ± 0.98*sqrt(n)
+    n = res->samples;
+    half = isqrt(n * 9604 / 10000);
+    lo = (n / 2 > half) ? (n / 2 - half) : 0;
+    hi = (n / 2 + half < n) ? (n / 2 + half) : (n - 1);
+
+    res->median_ps = ticks_to_ps(sample_buf[first + n / 2], iterations);
+    res->ci_low_ps = ticks_to_ps(sample_buf[first + lo], iterations);
+    res->ci_high_ps = ticks_to_ps(sample_buf[first + hi], iterations);
+    res->min_ps = ticks_to_ps(sample_buf[first], iterations);
+    res->max_ps = ticks_to_ps(sample_buf[first + n - 1], iterations);
+
+    return 0;
+}
+
+/* 基准测试套件与回归比较 ==================================================== */
+
+static TimerLib_Handle suite_handle;
+static TimerLib_Handle16 suite_handle16;
+static volatile uint64_t suite_sink;
+
+static void suite_timestamp_us(void *ctx) { (void)ctx; suite_sink = TimerLib_GetTimestamp_us(); }
+static void suite_timestamp_tick(void *ctx) { (void)ctx; suite_sink = TimerLib_GetTimestamp_tick(); }
+static void suite_timestamp_sf(void *ctx) { (void)ctx; suite_sink = (uint64_t)TimerLib_GetTimestamp_sf(); }
+static void suite_timestamp_df(void *ctx) { (void)ctx; suite_sink = (uint64_t)TimerLib_GetTimestamp_df(); }
+static void suite_init_handle(void *ctx) { (void)ctx; TimerLib_InitHandle(&suite_handle); }
+static void suite_interval_us(void *ctx) { (void)ctx; suite_sink = TimerLib_GetInterval_us(&suite_handle); }
+static void suite_interval_ns(void *ctx) { (void)ctx; suite_sink = TimerLib_GetInterval_ns(&suite_handle); }
+static void suite_interval_sf(void *ctx) { (void)ctx; suite_sink = (uint64_t)TimerLib_GetInterval_sf(&suite_handle); }
+static void suite_interval_df(void *ctx) { (void)ctx; suite_sink = (uint64_t)TimerLib_GetInterval_df(&suite_handle); }
+static void suite_interval_sd(void *ctx) { (void)ctx; suite_sink = (uint64_t)TimerLib_GetInterval_sd(&suite_handle); }
+static void suite_timestamp_q32(void *ctx) { (void)ctx; suite_sink = TimerLib_GetTimestamp_q32(); }
+static void suite_interval_q32(void *ctx) { (void)ctx; suite_sink = TimerLib_GetInterval_q32(&suite_handle); }
+static void suite_interval_q16(void *ctx) { (void)ctx; suite_sink = TimerLib_GetInterval_q16(&suite_handle); }
+static void suite_init_handle16(void *ctx) { (void)ctx; TimerLib_InitHandle16(&suite_handle16); }
+static void suite_interval16_ticks(void *ctx) { (void)ctx; suite_sink = TimerLib_GetInterval16_ticks(&suite_handle16); }
+static void suite_interval16_us(void *ctx) { (void)ctx; suite_sink = TimerLib_GetInterval16_us(&suite_handle16); }
+
+static const struct
+{
+    const char *name;
+    TimerLib_BenchFunc fn;
+} suite_calls[] = {
+    {"GetTimestamp_us_ps", suite_timestamp_us},
+    {"GetTimestamp_tick_ps", suite_timestamp_tick},
+    {"GetTimestamp_sf_ps", suite_timestamp_sf},
+    {"GetTimestamp_df_ps", suite_timestamp_df},
+    {"InitHandle_ps", suite_init_handle},
+    {"GetInterval_us_ps", suite_interval_us},
+    {"GetInterval_ns_ps", suite_interval_ns},
+    {"GetInterval_sf_ps", suite_interval_sf},
+    {"GetInterval_df_ps", suite_interval_df},
+    {"GetInterval_sd_ps", suite_interval_sd},
+    {"GetTimestamp_q32_ps", suite_timestamp_q32},
+    {"GetInterval_q32_ps", suite_interval_q32},
+    {"GetInterval_q16_ps", suite_interval_q16},
+    {"InitHandle16_ps", suite_init_handle16},
+    {"GetInterval16_ticks_ps", suite_interval16_ticks},
+    {"GetInterval16_us_ps", suite_interval16_us},
+};
+
+#define SUITE_DELAY_RUNS 15
+
+static uint64_t delay_overshoot_ns(int kind, uint32_t amount)
+{
+    uint32_t runs[SUITE_DELAY_RUNS];
+    uint64_t start, ns, target_ns;
+
+    // kind: 0 DelayNS, 1 DelayUS, 2 DelayUS_32Short, 3 DelayUS_32, 4 Delay_ns; 0和4的amount为纳秒
+    target_ns = (kind == 0 || kind == 4) ? amount : (uint64_t)amount * 1000;
+    for (uint32_t i = 0; i < SUITE_DELAY_RUNS; i++)
+    {
+        start = TimerLib_GetTimestamp_tick();
+        if (kind == 0)
+        {
+            TimerLib_DelayNS(amount);
+        }
+        else if (kind == 1)
+        {
+            TimerLib_DelayUS(amount);
+        }
+        else if (kind == 2)
+        {
+            TimerLib_DelayUS_32Short(amount);
+        }
+        else if (kind == 3)
+        {
+            TimerLib_DelayUS_32(amount);
+        }
+        else
+        {
+            TimerLib_Delay_ns(amount);
+        }
+        ns = (TimerLib_GetTimestamp_tick() - start) * 1000000000 / TimerLib_GetClockFreq();
+        runs[i] = (ns > target_ns) ? (uint32_t)(ns - target_ns) : 0;
+    }
+    sort_samples(runs, SUITE_DELAY_RUNS);
+    return runs[SUITE_DELAY_RUNS / 2];
+}
+
+uint32_t TimerLib_Bench_RunSuite(TimerLib_BenchMetric *metrics, uint32_t max)
+{
+    TimerLib_BenchConfig cfg;
+    uint32_t buf[TIMERLIB_BENCH_MAX_SAMPLES];
+    TimerLib_BenchResult res;
+    uint32_t n = 0;
+
+    if (max < TIMERLIB_BENCH_SUITE_SIZE)
+    {
+        return 0;
+    }
+
+    TimerLib_Bench_DefaultConfig(&cfg, buf, TIMERLIB_BENCH_MAX_SAMPLES);
+    TimerLib_InitHandle(&suite_handle);
+    TimerLib_InitHandle16(&suite_handle16);
+    for (uint32_t i = 0; i < sizeof(suite_calls) / sizeof(suite_calls[0]); i++)
+    {
+        metrics[n].name = suite_calls[i].name;
+        metrics[n].value = (TimerLib_Bench_Run(&cfg, suite_calls[i].fn, 0, &res) == 0) ? res.median_ps : 0;
+        n++;
+    }
+
+    metrics[n].name = "DelayNS_1000_overshoot_ns";
+    metrics[n++].value = delay_overshoot_ns(0, 1000);
+    metrics[n].name = "DelayUS_10_overshoot_ns";
+    metrics[n++].value = delay_overshoot_ns(1, 10);
+    metrics[n].name = "DelayUS_1000_overshoot_ns";
+    metrics[n++].value = delay_overshoot_ns(1, 1000);
+    metrics[n].name = "DelayUS_32Short_10_overshoot_ns";
+    metrics[n++].value = delay_overshoot_ns(2, 10);
+    metrics[n].name = "DelayUS_32_10_overshoot_ns";
+    metrics[n++].value = delay_overshoot_ns(3, 10);
+    metrics[n].name = "Delay_ns_1000_overshoot_ns";
+    metrics[n++].value = delay_overshoot_ns(4, 1000);
+    metrics[n].name = "Delay_ns_100000_overshoot_ns";
+    metrics[n++].value = delay_overshoot_ns(4, 100000);
+
+    return n;
+}
+
+static void clock_read(void *ctx)
+{
+    suite_sink = ((const TimerLib_BenchClock *)ctx)->read();
+}
+
+int TimerLib_Bench_Clock(const TimerLib_BenchClock *clk, uint32_t reads, TimerLib_BenchClockResult *res)
+{
+    TimerLib_BenchConfig cfg;
+    uint32_t buf[TIMERLIB_BENCH_MAX_SAMPLES];
+    TimerLib_BenchResult bench;
+    uint64_t prev, now, min_delta = UINT64_MAX;
+
+    TimerLib_Bench_DefaultConfig(&cfg, buf, TIMERLIB_BENCH_MAX_SAMPLES);
+    if (clk->freq == 0 || TimerLib_Bench_Run(&cfg, clock_read, (void *)clk, &bench) != 0)
+    {
+        return -1;
+    }
+    res->call_ps = bench.median_ps;
+    res->backwards = 0;
+    res->repeats = 0;
+
+    prev = clk->read();
+    for (uint32_t i = 0; i < reads; i++)
+    {
+        now = clk->read();
+        if (now < prev)
+        {
+            res->backwards++;
+        }
+        else if (now == prev)
+        {
+            res->repeats++;
+        }
+        else if (now - prev < min_delta)
+        {
+            min_delta = now - prev;
+        }
+        prev = now;
+    }
+
+    if (min_delta == UINT64_MAX)
+    {
+        res->resolution_ps = 0;
+    }
+    else if (min_delta < UINT64_MAX / 1000000000000)
+    {
+        res->resolution_ps = min_delta * 1000000000000 / clk->freq;
+    }
+    else
+    {
+        res->resolution_ps = min_delta / clk->freq * 1000000000000;
+    }
+    return 0;
+}
+
+/**
+ * @brief 简单的字符串输出缓冲
+ */
+typedef struct
+{
+    char *buf;
+    uint32_t size;
+    uint32_t len;
+    bool overflow;
+} TextBuf;
+
+static void text_puts(TextBuf *t, const char *s)
+{
+    while (*s != '\0')
+    {
+        if (t->len + 1 >= t->size)
+        {
+            t->overflow = true;
+            return;
+        }
+        t->buf[t->len++] = *s++;
+    }
+    t->buf[t->len] = '\0';
+}
+
+static void text_putu(TextBuf *t, uint64_t v)
+{
+    char digits[TIMERLIB_FORMAT_MAX];
+
+    TimerLib_Format_U64(digits, sizeof(digits), v);
+    text_puts(t, digits);
+}
+
+static void text_pad(TextBuf *t, uint32_t column)
+{
+    while (t->len < column)
+    {
+        text_puts(t, " ");
+    }
+}
+
+int TimerLib_Bench_WriteJSON(const TimerLib_BenchMetric *metrics, uint32_t count, char *buf, uint32_t size)
+{
+    TextBuf t = {buf, size, 0, false};
+
+    if (size == 0)
+    {
+        return -1;
+    }
+    buf[0] = '\0';
+
+    text_puts(&t, "{");
+    for (uint32_t i = 0; i < count; i++)
+    {
+        text_puts(&t, (i == 0) ? "\n  \"" : ",\n  \"");
+        text_puts(&t, metrics[i].name);
+        text_puts(&t, "\": ");
+        text_putu(&t, metrics[i].value);
+    }
+    text_puts(&t, "\n}\n");
+
+    return t.overflow ? -1 : (int)t.len;
+}
+
+/**
+ * @brief 在基线JSON中查找指标值，仅支持WriteJSON产生的扁平格式
+ */
+static bool baseline_lookup(const char *json, const char *name, uint64_t *value)
+{
+    const char *p = json;
+
+    while ((p = strchr(p, '"')) != 0)
+    {
+        const char *key = ++p;
+        const char *n = name;
+
+        while (*n != '\0' && *p == *n)
+        {
+            p++;
+            n++;
+        }
+        if (*n == '\0' && *p == '"')
+        {
+            p++;
+            while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n' || *p == ':')
+            {
+                p++;
+            }
+            if (*p < '0' || *p > '9')
+            {
+                return false;
+            }
+            *value = 0;
+            while (*p >= '0' && *p <= '9')
+            {
+                *value = *value * 10 + (uint64_t)(*p++ - '0');
+            }
+            return true;
+        }
+
+        // 跳过该字符串剩余部分
+        p = strchr(key, '"');
+        if (p == 0)
+        {
+            return false;
+        }
+        p++;
+    }
+    return false;
+}
+
+int TimerLib_Bench_Compare(const TimerLib_BenchMetric *metrics, uint32_t count, const char *baseline_json,
+                           const TimerLib_BenchTolerance *tol, uint32_t tol_count, uint32_t default_tol_pct,
+                           TimerLib_BenchOutput out, void *ctx)
+{
+    char line[96];
+    TextBuf t;
+    int regressions = 0;
+
+    if (out != 0)
+    {
+        t = (TextBuf){line, sizeof(line), 0, false};
+        text_puts(&t, "metric");
+        text_pad(&t, 34);
+        text_puts(&t, "baseline");
+        text_pad(&t, 48);
+        text_puts(&t, "current");
+        text_pad(&t, 62);
+        text_puts(&t, "delta%  status");
+        out(line, ctx);
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint64_t base;
+        uint32_t limit = default_tol_pct;
+        const char *status;
+        bool found = baseline_lookup(baseline_json, metrics[i].name, &base);
+        int64_t delta_pct = 0;
+
+        for (uint32_t j = 0; j < tol_count; j++)
+        {
+            if (strcmp(tol[j].name, metrics[i].name) == 0)
+            {
+                limit = tol[j].tolerance_pct;
+            }
+        }
+
+        if (!found)
+        {
+            status = "new";
+        }
+        else
+        {
+            // 基线为0时按1计算，避免除零
+            uint64_t ref = (base != 0) ? base : 1;
+
+            delta_pct = ((int64_t)metrics[i].value - (int64_t)base) * 100 / (int64_t)ref;
+            if (metrics[i].value * 100 > ref * (100 + limit))
+            {
+                status = "REGRESSED";
+                regressions++;
+            }
+            else
+            {
+                status = "ok";
+            }
+        }
+
+        if (out != 0)
+        {
+            t = (TextBuf){line, sizeof(line), 0, false};
+            text_puts(&t, metrics[i].name);
+            text_pad(&t, 34);
+            if (found)
+            {
+                text_putu(&t, base);
+            }
+            else
+            {
+                text_puts(&t, "-");
+            }
+            text_pad(&t, 48);
+            text_putu(&t, metrics[i].value);
+            text_pad(&t, 62);
+            if (found)
+            {
+                text_puts(&t, (delta_pct < 0) ? "-" : "+");
+                text_putu(&t, (uint64_t)((delta_pct < 0) ? -delta_pct : delta_pct));
+            }
+            text_pad(&t, 70);
+            text_puts(&t, status);
+            out(line, ctx);
+        }
+    }
+
+    return regressions;
+}
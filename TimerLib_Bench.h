@@ -0,0 +1,170 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* TimerLib_Bench.h */
+#pragma once
+#include "TimerLib.h"
+
+#ifndef TIMERLIB_BENCH_MAX_SAMPLES
+#define TIMERLIB_BENCH_MAX_SAMPLES 64 // 套件与时钟比较在栈上使用的样本数
+#endif
+
+/**
+ * @brief 被测函数
+ * @param ctx 用户上下文
+ */
+typedef void (*TimerLib_BenchFunc)(void *ctx);
+
+/**
+ * @brief 基准测试配置
+ */
+typedef struct {
+    uint32_t *buf;             // 样本缓冲区，容量不小于samples
+    uint32_t samples;          // 采样次数，不少于4
+    uint32_t warmup;           // 预热调用次数
+    uint32_t min_sample_ticks; // 每个样本的最短时长(tick)，0表示自动
+} TimerLib_BenchConfig;
+
+/**
+ * @brief 基准测试结果，时间均为单次调用耗时
+ */
+typedef struct {
+    uint32_t iterations;     // 每个样本的调用次数(自动标定)
+    uint32_t samples;        // 有效样本数
+    uint32_t rejected;       // 剔除的离群样本数
+    uint32_t overhead_ticks; // 每个样本扣除的计时与循环开销(tick)
+    uint64_t median_ps;      // 中位数(皮秒)
+    uint64_t ci_low_ps;      // 中位数95%置信区间下限(皮秒)
+    uint64_t ci_high_ps;     // 中位数95%置信区间上限(皮秒)
+    uint64_t min_ps;         // 最小值(皮秒)
+    uint64_t max_ps;         // 最大值(皮秒，剔除离群值后)
+} TimerLib_BenchResult;
+
+/**
+ * @brief 基准测试指标，数值越大表示越慢
+ */
+typedef struct {
+    const char *name; // 指标名称
+    uint64_t value;   // 指标值(调用耗时为皮秒，延时超调为纳秒)
+} TimerLib_BenchMetric;
+
+/**
+ * @brief 单个指标的回归容差
+ */
+typedef struct {
+    const char *name;      // 指标名称
+    uint32_t tolerance_pct; // 允许的增长百分比
+} TimerLib_BenchTolerance;
+
+/**
+ * @brief 文本输出回调，每次输出一行(不含换行符)
+ * @param line 文本行
+ * @param ctx 用户上下文
+ */
+typedef void (*TimerLib_BenchOutput)(const char *line, void *ctx);
+
+/**
+ * @brief 待比较的时钟源
+ */
+typedef struct {
+    const char *name;     // 时钟名称
+    uint64_t (*read)(void); // 读取函数
+    uint64_t freq;        // 读取值的频率(Hz)，纳秒时钟为1000000000
+} TimerLib_BenchClock;
+
+/**
+ * @brief 时钟源比较结果
+ */
+typedef struct {
+    uint64_t call_ps;       // 单次读取耗时中位数(皮秒)
+    uint64_t resolution_ps; // 连续读取观察到的最小非零增量(皮秒)
+    uint32_t backwards;     // 读值回退次数(非单调)
+    uint32_t repeats;       // 连续读值相同的次数
+} TimerLib_BenchClockResult;
+
+#define TIMERLIB_BENCH_SUITE_SIZE 23 // TimerLib_Bench_RunSuite 产生的指标数
+
+/**
+ * @brief 获取默认配置
+ * @param cfg 配置指针
+ * @param buf 调用者提供的样本缓冲区
+ * @param capacity 缓冲区容量，作为采样次数
+ */
+void TimerLib_Bench_DefaultConfig(TimerLib_BenchConfig *cfg, uint32_t *buf, uint32_t capacity);
+
+/**
+ * @brief 运行基准测试
+ * @param cfg 配置指针
+ * @param fn 被测函数
+ * @param ctx 传给被测函数的上下文
+ * @param res 结果指针
+ * @return 0表示成功，-1表示配置无效
+ * @note 样本存放在cfg->buf中，使用不同缓冲区的调用互不影响
+ */
+int TimerLib_Bench_Run(const TimerLib_BenchConfig *cfg, TimerLib_BenchFunc fn, void *ctx,
+                       TimerLib_BenchResult *res);
+
+/**
+ * @brief 对TimerLib的每个API运行基准测试
+ * @param metrics 指标数组，容量不小于TIMERLIB_BENCH_SUITE_SIZE
+ * @param max 指标数组容量
+ * @return 写入的指标数
+ * @note 调用耗时指标名以"_ps"结尾，延时超调指标名以"_overshoot_ns"结尾
+ */
+uint32_t TimerLib_Bench_RunSuite(TimerLib_BenchMetric *metrics, uint32_t max);
+
+/**
+ * @brief 将指标写为JSON对象，如 {"GetTimestamp_us_ps": 1234}
+ * @param metrics 指标数组
+ * @param count 指标数
+ * @param buf 输出缓冲区
+ * @param size 缓冲区大小
+ * @return 写入的字符数(不含结尾0)，-1表示缓冲区不足
+ */
+int TimerLib_Bench_WriteJSON(const TimerLib_BenchMetric *metrics, uint32_t count, char *buf, uint32_t size);
+
+/**
+ * @brief 与基线JSON比较，输出差异表
+ * @param metrics 当前指标数组
+ * @param count 指标数
+ * @param baseline_json TimerLib_Bench_WriteJSON格式的基线
+ * @param tol 单独指定容差的指标，可为NULL
+ * @param tol_count 单独指定容差的指标数
+ * @param default_tol_pct 默认容差百分比
+ * @param out 差异表输出回调，可为NULL
+ * @param ctx 传给输出回调的上下文
+ * @return 超出容差的指标数，0表示无回归
+ */
+int TimerLib_Bench_Compare(const TimerLib_BenchMetric *metrics, uint32_t count, const char *baseline_json,
+                           const TimerLib_BenchTolerance *tol, uint32_t tol_count, uint32_t default_tol_pct,
+                           TimerLib_BenchOutput out, void *ctx);
+
+/**
+ * @brief 测量时钟源的读取耗时、分辨率与单调性
+ * @param clk 时钟源
+ * @param reads 用于检查分辨率与单调性的连续读取次数
+ * @param res 结果指针
+ * @return 0表示成功，-1表示基准测试失败
+ */
+int TimerLib_Bench_Clock(const TimerLib_BenchClock *clk, uint32_t reads, TimerLib_BenchClockResult *res);
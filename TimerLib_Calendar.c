@@ -0,0 +1,228 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file TimerLib_Calendar.c
+ * @brief 软件日历时钟实现
+ */
+#include "TimerLib_Calendar.h"
+
+// 字段在格式化字符串中的位置
+#define POS_YEAR   0
+#define POS_MONTH  5
+#define POS_DAY    8
+#define POS_HOUR   11
+#define POS_MINUTE 14
+#define POS_SECOND 17
+
+static bool is_leap(uint32_t year)
+{
+    return (year % 4 == 0) && (year % 100 != 0 || year % 400 == 0);
+}
+
+static uint8_t days_in_month(uint32_t year, uint32_t month)
+{
+    static const uint8_t days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+    return (month == 2 && is_leap(year)) ? 29 : days[month - 1];
+}
+
+static void put_digits(char *p, uint32_t value, uint32_t width)
+{
+    while (width-- > 0)
+    {
+        p[width] = (char)('0' + value % 10);
+        value /= 10;
+    }
+}
+
+/**
+ * @brief 两位数字符加一, 不处理进位(调用方保证字段未到上限)
+ */
+static void inc_digits2(char *p)
+{
+    if (p[1] != '9')
+    {
+        p[1]++;
+    }
+    else
+    {
+        p[1] = '0';
+        p[0]++;
+    }
+}
+
+static void format_all(TimerLib_Calendar *cal)
+{
+    put_digits(&cal->text[POS_YEAR], cal->year, 4);
+    cal->text[4] = '-';
+    put_digits(&cal->text[POS_MONTH], cal->month, 2);
+    cal->text[7] = '-';
+    put_digits(&cal->text[POS_DAY], cal->day, 2);
+    cal->text[10] = ' ';
+    put_digits(&cal->text[POS_HOUR], cal->hour, 2);
+    cal->text[13] = ':';
+    put_digits(&cal->text[POS_MINUTE], cal->minute, 2);
+    cal->text[16] = ':';
+    put_digits(&cal->text[POS_SECOND], cal->second, 2);
+    cal->text[19] = '\0';
+}
+
+/**
+ * @brief 前进一秒, 逐级进位, 只改写变化的字符
+ */
+static void advance_second(TimerLib_Calendar *cal)
+{
+    cal->unix_seconds++;
+    if (++cal->second < 60)
+    {
+        inc_digits2(&cal->text[POS_SECOND]);
+        return;
+    }
+    cal->second = 0;
+    cal->text[POS_SECOND] = cal->text[POS_SECOND + 1] = '0';
+
+    if (++cal->minute < 60)
+    {
+        inc_digits2(&cal->text[POS_MINUTE]);
+        return;
+    }
+    cal->minute = 0;
+    cal->text[POS_MINUTE] = cal->text[POS_MINUTE + 1] = '0';
+
+    if (++cal->hour < 24)
+    {
+        inc_digits2(&cal->text[POS_HOUR]);
+        return;
+    }
+    cal->hour = 0;
+    cal->text[POS_HOUR] = cal->text[POS_HOUR + 1] = '0';
+
+    // 日期以上每天最多变化一次, 直接重新格式化
+    if (++cal->day > cal->month_days)
+    {
+        cal->day = 1;
+        if (++cal->month > 12)
+        {
+            cal->month = 1;
+            cal->year++;
+        }
+        cal->month_days = days_in_month(cal->year, cal->month);
+    }
+    format_all(cal);
+}
+
+/**
+ * @brief 由Unix时间求日期时间字段(公历400年周期算法)
+ */
+static void set_unix(TimerLib_Calendar *cal, uint64_t unix_seconds)
+{
+    uint32_t days = (uint32_t)(unix_seconds / 86400);
+    uint32_t secs = (uint32_t)(unix_seconds % 86400);
+    uint32_t z = days + 719468;
+    uint32_t era = z / 146097;
+    uint32_t doe = z - era * 146097;
+    uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    uint32_t mp = (5 * doy + 2) / 153;
+
+    cal->unix_seconds = unix_seconds;
+    cal->day = (uint8_t)(doy - (153 * mp + 2) / 5 + 1);
+    cal->month = (uint8_t)((mp < 10) ? mp + 3 : mp - 9);
+    cal->year = (uint16_t)(yoe + era * 400 + (cal->month <= 2));
+    cal->hour = (uint8_t)(secs / 3600);
+    cal->minute = (uint8_t)(secs / 60 % 60);
+    cal->second = (uint8_t)(secs % 60);
+    cal->month_days = days_in_month(cal->year, cal->month);
+    format_all(cal);
+}
+
+int TimerLib_Calendar_InitUnix(TimerLib_Calendar *cal, uint64_t unix_seconds)
+{
+    // 与TimerLib_Calendar_Init的年份上限一致, 年份超过4位时格式化字符串放不下
+    if (unix_seconds > TIMERLIB_CALENDAR_UNIX_MAX)
+    {
+        return -1;
+    }
+
+    cal->ticks_per_second = TimerLib_GetClockFreq();
+    cal->next_second = TimerLib_GetTimestamp_tick() + cal->ticks_per_second;
+    set_unix(cal, unix_seconds);
+    return 0;
+}
+
+int TimerLib_Calendar_Init(TimerLib_Calendar *cal, uint16_t year, uint8_t month, uint8_t day,
+                           uint8_t hour, uint8_t minute, uint8_t second)
+{
+    uint32_t y, era, yoe, doy, doe;
+    uint64_t days;
+
+    // 1970年之前的天数为负, 下面的无符号运算会回绕; 年份为0且月份不超过2时y也会下溢
+    if (year < 1970 || year > 9999 || month < 1 || month > 12 || day < 1 || day > days_in_month(year, month) ||
+        hour > 23 || minute > 59 || second > 59)
+    {
+        return -1;
+    }
+
+    // 由年月日求自1970-01-01起的天数(上面算法的逆运算)
+    y = (uint32_t)year - (month <= 2);
+    era = y / 400;
+    yoe = y - era * 400;
+    doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    days = (uint64_t)era * 146097 + doe - 719468;
+
+    return TimerLib_Calendar_InitUnix(cal, days * 86400 + hour * 3600u + minute * 60u + second);
+}
+
+void TimerLib_Calendar_Update(TimerLib_Calendar *cal)
+{
+    uint64_t now = TimerLib_GetTimestamp_tick();
+
+    if (now < cal->next_second)
+    {
+        return;
+    }
+
+    // 长时间未调用时一次性换算, 稳态下每秒只走下面的进位路径
+    if (now - cal->next_second >= (uint64_t)cal->ticks_per_second * 60)
+    {
+        uint64_t seconds = (now - cal->next_second) / cal->ticks_per_second;
+
+        cal->next_second += seconds * cal->ticks_per_second;
+        set_unix(cal, cal->unix_seconds + seconds);
+    }
+
+    while (now >= cal->next_second)
+    {
+        advance_second(cal);
+        cal->next_second += cal->ticks_per_second;
+    }
+}
+
+const char *TimerLib_Calendar_Get(TimerLib_Calendar *cal)
+{
+    TimerLib_Calendar_Update(cal);
+    return cal->text;
+}
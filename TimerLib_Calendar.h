@@ -0,0 +1,95 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* TimerLib_Calendar.h */
+#pragma once
+#include "TimerLib.h"
+
+/*
+ * 软件日历时钟
+ *
+ * 缓存当前的年月日时分秒及其格式化字符串，记录下一秒开始的tick。读取时
+ * 只需比较一次时间戳，跨过秒边界才逐级进位并只改写变化的字符，稳态下没有除法:
+ *
+ *   TimerLib_Calendar cal;
+ *   TimerLib_Calendar_InitUnix(&cal, 1760000000);
+ *   log_printf("%s ...", TimerLib_Calendar_Get(&cal));  // "2025-10-09 08:53:20"
+ */
+
+#define TIMERLIB_CALENDAR_TEXT_LEN 20 // "YYYY-MM-DD hh:mm:ss" 加结束符
+#define TIMERLIB_CALENDAR_UNIX_MAX 253402300799ull // 9999-12-31 23:59:59
+
+/**
+ * @brief 日历时钟
+ */
+typedef struct {
+    uint16_t year;
+    uint8_t month;  // 1~12
+    uint8_t day;    // 1~31
+    uint8_t hour;   // 0~23
+    uint8_t minute; // 0~59
+    uint8_t second; // 0~59
+    uint8_t month_days; // 本月天数
+    uint64_t unix_seconds; // 当前秒对应的Unix时间
+
+    uint64_t next_second;    // 下一秒开始的时刻(tick)
+    uint32_t ticks_per_second;
+    char text[TIMERLIB_CALENDAR_TEXT_LEN]; // 格式化字符串
+} TimerLib_Calendar;
+
+/**
+ * @brief 以日期时间初始化，当前时刻为该秒的开始
+ * @param cal 日历时钟指针
+ * @param year 年(1970~9999)，Unix时间不能表示1970年之前的日期
+ * @param month 月(1~12)
+ * @param day 日(1~当月天数)
+ * @param hour 时(0~23)
+ * @param minute 分(0~59)
+ * @param second 秒(0~59)
+ * @return 0表示成功，-1表示日期时间超出范围(日历时钟未修改)
+ */
+int TimerLib_Calendar_Init(TimerLib_Calendar *cal, uint16_t year, uint8_t month, uint8_t day,
+                            uint8_t hour, uint8_t minute, uint8_t second);
+
+/**
+ * @brief 以Unix时间初始化，当前时刻为该秒的开始
+ * @param cal 日历时钟指针
+ * @param unix_seconds 自1970-01-01 00:00:00起的秒数，不超过TIMERLIB_CALENDAR_UNIX_MAX(9999-12-31 23:59:59)
+ * @return 0表示成功，-1表示超出范围(日历时钟未修改)
+ */
+int TimerLib_Calendar_InitUnix(TimerLib_Calendar *cal, uint64_t unix_seconds);
+
+/**
+ * @brief 按当前时间戳推进日历
+ * @param cal 日历时钟指针
+ * @note 两次调用间隔超过一分钟时由Unix时间一次性换算，会用到除法
+ */
+void TimerLib_Calendar_Update(TimerLib_Calendar *cal);
+
+/**
+ * @brief 推进日历并返回格式化字符串 "YYYY-MM-DD hh:mm:ss"
+ * @param cal 日历时钟指针
+ * @return 字符串指针，指向cal内部缓存
+ */
+const char *TimerLib_Calendar_Get(TimerLib_Calendar *cal);
@@ -0,0 +1,125 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file TimerLib_ClockMap.c
+ * @brief 时钟域换算实现
+ */
+#include "TimerLib_ClockMap.h"
+#include <math.h>
+
+/**
+ * @brief 计算 (a * q) >> 32, 只使用32x32位乘法, 结果按2^64取模
+ */
+static uint64_t mul_q32(uint64_t a, uint64_t q)
+{
+    uint64_t ah = a >> 32, al = (uint32_t)a;
+    uint64_t qh = q >> 32, ql = (uint32_t)q;
+
+    return ((ah * qh) << 32) + ah * ql + al * qh + ((al * ql) >> 32);
+}
+
+void TimerLib_ClockMap_Init(TimerLib_ClockMap *map, uint32_t src_freq, uint32_t dst_freq)
+{
+    map->head = 0;
+    map->count = 0;
+    map->src_ref = 0;
+    map->dst_ref = 0;
+    map->nominal_q32 = ((uint64_t)dst_freq << 32) / src_freq;
+    map->slope_q32 = map->nominal_q32;
+    map->error_bound = 0;
+}
+
+void TimerLib_ClockMap_AddSample(TimerLib_ClockMap *map, uint64_t src, uint64_t dst)
+{
+    double mean_x = 0, mean_y = 0, sxx = 0, sxy = 0, slope, max_res = 0;
+    uint32_t i;
+
+    map->src[map->head] = src;
+    map->dst[map->head] = dst;
+    map->head = (map->head + 1) % TIMERLIB_CLOCKMAP_WINDOW;
+    if (map->count < TIMERLIB_CLOCKMAP_WINDOW)
+    {
+        map->count++;
+    }
+
+    // 以最新样本为原点, 差值较小, 双精度可以精确表示
+    for (i = 0; i < map->count; i++)
+    {
+        mean_x += (double)(int64_t)(map->src[i] - src);
+        mean_y += (double)(int64_t)(map->dst[i] - dst);
+    }
+    mean_x /= map->count;
+    mean_y /= map->count;
+    for (i = 0; i < map->count; i++)
+    {
+        double x = (double)(int64_t)(map->src[i] - src) - mean_x;
+        double y = (double)(int64_t)(map->dst[i] - dst) - mean_y;
+
+        sxx += x * x;
+        sxy += x * y;
+    }
+
+    // 样本不足或源时钟读数相同时保留上一次的频率比
+    slope = (sxx > 0 && sxy > 0) ? sxy / sxx : (double)map->slope_q32 / 4294967296.0;
+    map->slope_q32 = (uint64_t)llround(slope * 4294967296.0);
+
+    // 参考点取最新样本, 换算最常用的近期时刻时增量最小
+    map->src_ref = src;
+    map->dst_ref = dst + (uint64_t)llround(mean_y - slope * mean_x);
+
+    for (i = 0; i < map->count; i++)
+    {
+        double res = fabs((double)(int64_t)(map->dst[i] - dst) - mean_y -
+                          slope * ((double)(int64_t)(map->src[i] - src) - mean_x));
+
+        if (res > max_res)
+        {
+            max_res = res;
+        }
+    }
+    // 加上参考点取整和换算截断各一个tick
+    map->error_bound = (uint32_t)ceil(max_res) + 2;
+}
+
+uint64_t TimerLib_ClockMap_Convert(const TimerLib_ClockMap *map, uint64_t src)
+{
+    int64_t delta = (int64_t)(src - map->src_ref);
+
+    if (delta >= 0)
+    {
+        return map->dst_ref + mul_q32((uint64_t)delta, map->slope_q32);
+    }
+    return map->dst_ref - mul_q32((uint64_t)-delta, map->slope_q32);
+}
+
+uint32_t TimerLib_ClockMap_ErrorBound(const TimerLib_ClockMap *map)
+{
+    return map->error_bound;
+}
+
+int32_t TimerLib_ClockMap_GetDrift_ppb(const TimerLib_ClockMap *map)
+{
+    return (int32_t)(((double)map->slope_q32 - (double)map->nominal_q32) / (double)map->nominal_q32 * 1e9);
+}
@@ -0,0 +1,100 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* TimerLib_ClockMap.h */
+#pragma once
+#include "TimerLib.h"
+
+/*
+ * 时钟域换算
+ *
+ * 两个频率不同的计数器(如另一块定时器、外部时钟)对同一事件成对打时间戳，
+ * 在固定大小的样本窗口上做最小二乘直线拟合，估计频率比和偏移并跟踪漂移。
+ * 换算只需一次Q32乘法和一次加法，拟合只在加入样本时进行:
+ *
+ *   TimerLib_ClockMap map;
+ *   TimerLib_ClockMap_Init(&map, 72000000, 32768);
+ *   TimerLib_ClockMap_AddSample(&map, TimerLib_GetTimestamp_tick(), lptim_ticks);
+ *   uint64_t t = TimerLib_ClockMap_Convert(&map, event_tick);
+ */
+
+#ifndef TIMERLIB_CLOCKMAP_WINDOW
+#define TIMERLIB_CLOCKMAP_WINDOW 16 // 拟合窗口样本数
+#endif
+
+/**
+ * @brief 时钟域换算器
+ */
+typedef struct {
+    uint64_t src[TIMERLIB_CLOCKMAP_WINDOW]; // 源时钟样本(tick)
+    uint64_t dst[TIMERLIB_CLOCKMAP_WINDOW]; // 目标时钟样本(tick)
+    uint32_t head;                          // 下一个样本写入位置
+    uint32_t count;                         // 有效样本数
+
+    uint64_t src_ref;   // 拟合直线的参考点(源时钟)
+    uint64_t dst_ref;   // 拟合直线在参考点处的值(目标时钟)
+    uint64_t slope_q32; // 频率比 目标/源 (Q32.32)
+    uint64_t nominal_q32; // 标称频率比 (Q32.32)
+    uint32_t error_bound; // 窗口内样本相对拟合直线的最大偏差(目标tick, 向上取整)
+} TimerLib_ClockMap;
+
+/**
+ * @brief 初始化换算器
+ * @param map 换算器指针
+ * @param src_freq 源时钟标称频率(Hz)
+ * @param dst_freq 目标时钟标称频率(Hz)
+ * @note 样本不足两个时按标称频率比换算
+ */
+void TimerLib_ClockMap_Init(TimerLib_ClockMap *map, uint32_t src_freq, uint32_t dst_freq);
+
+/**
+ * @brief 加入一对同一时刻的样本并重新拟合，窗口满后丢弃最旧的样本
+ * @param map 换算器指针
+ * @param src 源时钟读数(tick)
+ * @param dst 目标时钟读数(tick)
+ */
+void TimerLib_ClockMap_AddSample(TimerLib_ClockMap *map, uint64_t src, uint64_t dst);
+
+/**
+ * @brief 将源时钟时刻换算到目标时钟
+ * @param map 换算器指针
+ * @param src 源时钟时刻(tick)
+ * @return 目标时钟时刻(tick)
+ */
+uint64_t TimerLib_ClockMap_Convert(const TimerLib_ClockMap *map, uint64_t src);
+
+/**
+ * @brief 获取换算误差界
+ * @param map 换算器指针
+ * @return 窗口范围内的换算误差上界(目标tick)
+ * @note 超出窗口范围外推时误差随漂移变化增大
+ */
+uint32_t TimerLib_ClockMap_ErrorBound(const TimerLib_ClockMap *map);
+
+/**
+ * @brief 获取实测频率比相对标称值的偏差
+ * @param map 换算器指针
+ * @return 偏差(ppb)，正值表示源时钟相对目标时钟偏慢
+ */
+int32_t TimerLib_ClockMap_GetDrift_ppb(const TimerLib_ClockMap *map);
@@ -0,0 +1,142 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file TimerLib_Cyclic.c
+ * @brief 时间触发循环执行器实现
+ */
+#include "TimerLib_Cyclic.h"
+
+static uint32_t gcd(uint32_t a, uint32_t b)
+{
+    while (b != 0)
+    {
+        uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+int TimerLib_Cyclic_Init(TimerLib_Cyclic *ce, const TimerLib_CyclicTask *tasks, uint32_t count, uint32_t minor_us)
+{
+    uint64_t major = 1;
+    uint32_t n = 0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (tasks[i].period == 0 || tasks[i].offset >= tasks[i].period)
+        {
+            return -1;
+        }
+        major = major / gcd((uint32_t)major, tasks[i].period) * tasks[i].period;
+        if (major > TIMERLIB_CYCLIC_MAX_FRAMES)
+        {
+            return -1;
+        }
+    }
+
+    // 展开调度表: 同一次帧内保持任务在表中的顺序
+    for (uint32_t f = 0; f < major; f++)
+    {
+        ce->frame_first[f] = (uint16_t)n;
+        ce->slot_overruns[f] = 0;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (f % tasks[i].period == tasks[i].offset)
+            {
+                if (n >= TIMERLIB_CYCLIC_MAX_DISPATCH)
+                {
+                    return -1;
+                }
+                ce->dispatch[n++] = tasks[i].fn;
+            }
+        }
+    }
+    ce->frame_first[major] = (uint16_t)n;
+
+    ce->minor_ticks = (uint32_t)((uint64_t)minor_us * TimerLib_GetClockFreq() / 1000000);
+    ce->major_frames = (uint32_t)major;
+    ce->frame = 0;
+    ce->deadline = 0;
+    ce->frames = 0;
+    ce->overruns = 0;
+    ce->last_overrun_frame = 0;
+    ce->jitter_min = UINT32_MAX;
+    ce->jitter_max = 0;
+    ce->jitter_sum = 0;
+
+    return (ce->minor_ticks == 0) ? -1 : 0;
+}
+
+void TimerLib_Cyclic_Start(TimerLib_Cyclic *ce)
+{
+    ce->frame = 0;
+    ce->deadline = TimerLib_GetTimestamp_tick();
+}
+
+bool TimerLib_Cyclic_RunFrame(TimerLib_Cyclic *ce)
+{
+    uint64_t start, end;
+    uint32_t jitter;
+    bool overrun;
+
+    TimerLib_DelayUntil_tick(ce->deadline);
+    start = TimerLib_GetTimestamp_tick();
+
+    // 启动抖动: 实际开始时刻相对帧起点的延迟
+    jitter = (uint32_t)(start - ce->deadline);
+    if (jitter < ce->jitter_min)
+    {
+        ce->jitter_min = jitter;
+    }
+    if (jitter > ce->jitter_max)
+    {
+        ce->jitter_max = jitter;
+    }
+    ce->jitter_sum += jitter;
+
+    for (uint32_t i = ce->frame_first[ce->frame]; i < ce->frame_first[ce->frame + 1]; i++)
+    {
+        ce->dispatch[i]();
+    }
+
+    ce->deadline += ce->minor_ticks;
+    end = TimerLib_GetTimestamp_tick();
+    overrun = (end > ce->deadline);
+    if (overrun)
+    {
+        ce->overruns++;
+        ce->last_overrun_frame = ce->frame;
+        ce->slot_overruns[ce->frame]++;
+    }
+
+    ce->frames++;
+    ce->frame++;
+    if (ce->frame >= ce->major_frames)
+    {
+        ce->frame = 0;
+    }
+    return overrun;
+}
@@ -0,0 +1,105 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* TimerLib_Cyclic.h */
+#pragma once
+#include "TimerLib.h"
+
+/*
+ * 时间触发的循环执行器(静态调度表)
+ *
+ * 任务在静态常量表中以次帧为单位声明周期与相位，主帧长度为所有周期的
+ * 最小公倍数。第f个次帧执行所有满足 f % period == offset 的任务，初始化时
+ * 展开为每个次帧的分派表，运行时按表顺序调用，不再逐任务取模。
+ *
+ *   static const TimerLib_CyclicTask tasks[] = {
+ *       TIMERLIB_CYCLIC_TASK(control_loop, 1, 0), // 每个次帧
+ *       TIMERLIB_CYCLIC_TASK(read_sensors, 2, 1), // 奇数次帧
+ *       TIMERLIB_CYCLIC_TASK(send_status, 10, 3), // 每10个次帧的第3帧
+ *   };
+ */
+
+#ifndef TIMERLIB_CYCLIC_MAX_FRAMES
+#define TIMERLIB_CYCLIC_MAX_FRAMES 32 // 主帧最大次帧数
+#endif
+
+#ifndef TIMERLIB_CYCLIC_MAX_DISPATCH
+#define TIMERLIB_CYCLIC_MAX_DISPATCH 64 // 一个主帧内的最大任务调用数
+#endif
+
+/**
+ * @brief 调度表项
+ */
+typedef struct {
+    void (*fn)(void); // 任务函数
+    uint16_t period;  // 周期(次帧数)
+    uint16_t offset;  // 相位(次帧数)，必须小于period
+} TimerLib_CyclicTask;
+
+#define TIMERLIB_CYCLIC_TASK(fn, period, offset) {(fn), (period), (offset)}
+#define TIMERLIB_CYCLIC_COUNT(tasks) (sizeof(tasks) / sizeof((tasks)[0]))
+
+/**
+ * @brief 循环执行器
+ */
+typedef struct {
+    void (*dispatch[TIMERLIB_CYCLIC_MAX_DISPATCH])(void); // 按次帧顺序展开的任务调用
+    uint16_t frame_first[TIMERLIB_CYCLIC_MAX_FRAMES + 1]; // 各次帧在dispatch中的起始位置
+    uint32_t minor_ticks;                                 // 次帧长度(tick)
+    uint32_t major_frames;                                // 主帧包含的次帧数
+    uint32_t frame;                                       // 下一个次帧序号
+    uint64_t deadline;                                    // 下一个次帧的起始时刻(tick)
+
+    uint32_t frames;                                    // 已执行次帧数
+    uint32_t overruns;                                  // 超时的次帧数
+    uint32_t last_overrun_frame;                        // 最近一次超时的次帧序号
+    uint32_t slot_overruns[TIMERLIB_CYCLIC_MAX_FRAMES]; // 主帧内各次帧位置的超时次数
+    uint32_t jitter_min;         // 次帧启动抖动最小值(tick)
+    uint32_t jitter_max;         // 次帧启动抖动最大值(tick)
+    uint64_t jitter_sum;         // 次帧启动抖动累计值(tick)
+} TimerLib_Cyclic;
+
+/**
+ * @brief 初始化循环执行器
+ * @param ce 执行器指针
+ * @param tasks 调度表
+ * @param count 任务数
+ * @param minor_us 次帧长度(微秒)
+ * @return 0表示成功，-1表示调度表无效或展开后超出TIMERLIB_CYCLIC_MAX_FRAMES/TIMERLIB_CYCLIC_MAX_DISPATCH
+ */
+int TimerLib_Cyclic_Init(TimerLib_Cyclic *ce, const TimerLib_CyclicTask *tasks, uint32_t count, uint32_t minor_us);
+
+/**
+ * @brief 以当前时刻作为第0个次帧的起点
+ * @param ce 执行器指针
+ */
+void TimerLib_Cyclic_Start(TimerLib_Cyclic *ce);
+
+/**
+ * @brief 等待下一个次帧的起始时刻并执行该帧的任务
+ * @param ce 执行器指针
+ * @return true表示该次帧超时(任务执行超过次帧结束时刻)
+ * @note 超时后帧时刻不做调整，落后的次帧会被立即连续执行；超时计入该次帧位置的slot_overruns
+ */
+bool TimerLib_Cyclic_RunFrame(TimerLib_Cyclic *ce);
@@ -0,0 +1,138 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file TimerLib_Defer.c
+ * @brief 延迟回调队列实现，基于序号槽位的有界无锁MPSC环形队列
+ * @note 依赖GCC __atomic 内建函数，Cortex-M3及以上由LDREX/STREX实现
+ */
+#include "TimerLib_Defer.h"
+
+#define QUEUE_MASK (TIMERLIB_DEFER_QUEUE_SIZE - 1)
+
+/**
+ * @brief 队列槽位
+ */
+typedef struct
+{
+    uint32_t seq;          // 槽位序号，用于判断槽位状态
+    TimerLib_DeferFunc fn; // 回调函数
+    void *arg;             // 回调参数
+} DeferSlot;
+
+static DeferSlot queue[TIMERLIB_DEFER_QUEUE_SIZE];
+static uint32_t enqueue_pos; // 生产者位置，多生产者竞争
+static uint32_t dequeue_pos; // 消费者位置，仅消费者访问
+static uint32_t dropped;
+
+void TimerLib_Defer_Init(void)
+{
+    for (uint32_t i = 0; i < TIMERLIB_DEFER_QUEUE_SIZE; i++)
+    {
+        __atomic_store_n(&queue[i].seq, i, __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&enqueue_pos, 0, __ATOMIC_RELAXED);
+    dequeue_pos = 0;
+    dropped = 0;
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+int TimerLib_Defer_Push(TimerLib_DeferFunc fn, void *arg)
+{
+    DeferSlot *slot;
+    uint32_t pos = __atomic_load_n(&enqueue_pos, __ATOMIC_RELAXED);
+
+    while (1)
+    {
+        slot = &queue[pos & QUEUE_MASK];
+        int32_t diff = (int32_t)(__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) - pos);
+
+        if (diff == 0)
+        {
+            // 槽位空闲，抢占该位置
+            if (__atomic_compare_exchange_n(&enqueue_pos, &pos, pos + 1, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // 消费者尚未取走上一轮的数据，队列已满
+            __atomic_fetch_add(&dropped, 1, __ATOMIC_RELAXED);
+            return -1;
+        }
+        else
+        {
+            pos = __atomic_load_n(&enqueue_pos, __ATOMIC_RELAXED);
+        }
+    }
+
+    slot->fn = fn;
+    slot->arg = arg;
+    __atomic_store_n(&slot->seq, pos + 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+uint32_t TimerLib_Defer_Dispatch(uint32_t budget_ticks)
+{
+    uint64_t start = 0;
+    uint32_t executed = 0;
+
+    if (budget_ticks != 0)
+    {
+        start = TimerLib_GetTimestamp_tick();
+    }
+
+    while (1)
+    {
+        DeferSlot *slot = &queue[dequeue_pos & QUEUE_MASK];
+        TimerLib_DeferFunc fn;
+        void *arg;
+
+        if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != dequeue_pos + 1)
+        {
+            break; // 队列为空或生产者尚未写完
+        }
+
+        fn = slot->fn;
+        arg = slot->arg;
+        __atomic_store_n(&slot->seq, dequeue_pos + TIMERLIB_DEFER_QUEUE_SIZE, __ATOMIC_RELEASE);
+        dequeue_pos++;
+
+        fn(arg);
+        executed++;
+
+        if (budget_ticks != 0 && TimerLib_GetTimestamp_tick() - start >= budget_ticks)
+        {
+            break;
+        }
+    }
+    return executed;
+}
+
+uint32_t TimerLib_Defer_GetDropped(void)
+{
+    return __atomic_load_n(&dropped, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,72 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* TimerLib_Defer.h */
+#pragma once
+#include "TimerLib.h"
+
+/*
+ * 延迟回调队列
+ *
+ * 中断中只把到期的工作压入无锁多生产者/单消费者队列，实际回调由主循环
+ * 或线程中的 TimerLib_Defer_Dispatch 执行，并限制每次执行的tick预算，
+ * 从而缩短中断占用时间。
+ */
+
+#ifndef TIMERLIB_DEFER_QUEUE_SIZE
+#define TIMERLIB_DEFER_QUEUE_SIZE 32 // 队列容量，必须为2的幂
+#endif
+
+/**
+ * @brief 延迟回调函数
+ * @param arg 用户参数
+ */
+typedef void (*TimerLib_DeferFunc)(void *arg);
+
+/**
+ * @brief 初始化延迟回调队列
+ */
+void TimerLib_Defer_Init(void);
+
+/**
+ * @brief 压入一个回调，可在任意中断或线程中调用
+ * @param fn 回调函数
+ * @param arg 回调参数
+ * @return 0表示成功，-1表示队列已满
+ */
+int TimerLib_Defer_Push(TimerLib_DeferFunc fn, void *arg);
+
+/**
+ * @brief 执行队列中的回调，只能在单一上下文中调用
+ * @param budget_ticks 本次执行的tick预算，0表示不限制
+ * @return 执行的回调数
+ * @note 预算在每个回调执行后检查，单个回调不会被打断
+ */
+uint32_t TimerLib_Defer_Dispatch(uint32_t budget_ticks);
+
+/**
+ * @brief 获取因队列已满而丢弃的回调数
+ * @return 丢弃的回调数
+ */
+uint32_t TimerLib_Defer_GetDropped(void);
@@ -0,0 +1,186 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file TimerLib_EDF.c
+ * @brief EDF协作式调度器实现
+ */
+#include "TimerLib_EDF.h"
+#include <stddef.h>
+
+static inline uint64_t heap_key(const TimerLib_EDFHeap *h, const TimerLib_EDFTask *t)
+{
+    return *(const uint64_t *)((const char *)t + h->key_offset);
+}
+
+static void heap_push(TimerLib_EDFHeap *h, TimerLib_EDFTask *t)
+{
+    uint32_t i = h->count++;
+    uint64_t key = heap_key(h, t);
+
+    // 上浮
+    while (i > 0)
+    {
+        uint32_t parent = (i - 1) / 2;
+
+        if (heap_key(h, h->items[parent]) <= key)
+        {
+            break;
+        }
+        h->items[i] = h->items[parent];
+        i = parent;
+    }
+    h->items[i] = t;
+}
+
+static TimerLib_EDFTask *heap_pop(TimerLib_EDFHeap *h)
+{
+    TimerLib_EDFTask *top = h->items[0];
+    TimerLib_EDFTask *last = h->items[--h->count];
+    uint64_t key = heap_key(h, last);
+    uint32_t i = 0;
+
+    // 下沉
+    while (1)
+    {
+        uint32_t child = i * 2 + 1;
+
+        if (child >= h->count)
+        {
+            break;
+        }
+        if (child + 1 < h->count && heap_key(h, h->items[child + 1]) < heap_key(h, h->items[child]))
+        {
+            child++;
+        }
+        if (key <= heap_key(h, h->items[child]))
+        {
+            break;
+        }
+        h->items[i] = h->items[child];
+        i = child;
+    }
+    if (h->count != 0)
+    {
+        h->items[i] = last;
+    }
+    return top;
+}
+
+static inline TimerLib_EDFTask *heap_peek(const TimerLib_EDFHeap *h)
+{
+    return (h->count != 0) ? h->items[0] : NULL;
+}
+
+static uint32_t us_to_ticks(uint32_t us)
+{
+    return (uint32_t)((uint64_t)us * TimerLib_GetClockFreq() / 1000000);
+}
+
+void TimerLib_EDF_Init(TimerLib_EDF *sched, TimerLib_EDFTask **ready_buf, TimerLib_EDFTask **waiting_buf,
+                       uint32_t capacity)
+{
+    sched->ready.items = ready_buf;
+    sched->ready.count = 0;
+    sched->ready.key_offset = offsetof(TimerLib_EDFTask, deadline);
+    sched->waiting.items = waiting_buf;
+    sched->waiting.count = 0;
+    sched->waiting.key_offset = offsetof(TimerLib_EDFTask, release);
+    sched->capacity = capacity;
+    sched->runs = 0;
+    sched->misses = 0;
+}
+
+int TimerLib_EDF_Add(TimerLib_EDF *sched, TimerLib_EDFTask *task, uint32_t period_us, uint32_t deadline_us,
+                     uint32_t offset_us)
+{
+    if (sched->ready.count + sched->waiting.count >= sched->capacity)
+    {
+        return -1;
+    }
+    // 单次任务没有周期可作为默认截止期, 截止期为0会使其排在所有作业之前且每次都计为错过
+    if (period_us == 0 && deadline_us == 0)
+    {
+        return -1;
+    }
+
+    task->period_ticks = us_to_ticks(period_us);
+    task->deadline_ticks = (deadline_us != 0) ? us_to_ticks(deadline_us) : task->period_ticks;
+    task->release = TimerLib_GetTimestamp_tick() + us_to_ticks(offset_us);
+    task->deadline = task->release + task->deadline_ticks;
+    task->runs = 0;
+    task->misses = 0;
+
+    heap_push(&sched->waiting, task);
+    return 0;
+}
+
+bool TimerLib_EDF_RunOnce(TimerLib_EDF *sched)
+{
+    TimerLib_EDFTask *task;
+    uint64_t now = TimerLib_GetTimestamp_tick();
+
+    // 将已到释放时刻的作业移入就绪堆
+    while ((task = heap_peek(&sched->waiting)) != NULL && task->release <= now)
+    {
+        heap_push(&sched->ready, heap_pop(&sched->waiting));
+    }
+
+    if (sched->ready.count == 0)
+    {
+        return false;
+    }
+
+    task = heap_pop(&sched->ready);
+    task->fn(task->ctx);
+    task->runs++;
+    sched->runs++;
+
+    if (TimerLib_GetTimestamp_tick() > task->deadline)
+    {
+        task->misses++;
+        sched->misses++;
+    }
+
+    // 周期任务释放下一个作业
+    if (task->period_ticks != 0)
+    {
+        task->release += task->period_ticks;
+        task->deadline = task->release + task->deadline_ticks;
+        heap_push(&sched->waiting, task);
+    }
+    return true;
+}
+
+uint64_t TimerLib_EDF_NextRelease(const TimerLib_EDF *sched)
+{
+    const TimerLib_EDFTask *task;
+
+    if (sched->ready.count != 0)
+    {
+        return 0;
+    }
+    task = heap_peek(&sched->waiting);
+    return (task != NULL) ? task->release : UINT64_MAX;
+}
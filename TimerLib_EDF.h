@@ -0,0 +1,105 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* TimerLib_EDF.h */
+#pragma once
+#include "TimerLib.h"
+
+/*
+ * 最早截止期优先(EDF)协作式调度器
+ *
+ * 已释放的任务按64位tick截止期存放在二叉堆中，未到释放时刻的任务按释放
+ * 时刻存放在另一个二叉堆中。插入为O(log n)，查看下一个任务为O(1)。
+ * 堆数组由调用者提供，调度器不做动态内存分配。
+ */
+
+/**
+ * @brief 调度任务
+ */
+typedef struct {
+    void (*fn)(void *ctx);   // 任务函数
+    void *ctx;               // 任务上下文
+    uint32_t period_ticks;   // 周期(tick)，0表示单次任务
+    uint32_t deadline_ticks; // 相对截止期(tick)
+    uint64_t release;        // 当前作业的释放时刻(tick)
+    uint64_t deadline;       // 当前作业的绝对截止期(tick)
+    uint32_t runs;           // 执行次数
+    uint32_t misses;         // 错过截止期的次数
+} TimerLib_EDFTask;
+
+/**
+ * @brief 二叉最小堆
+ */
+typedef struct {
+    TimerLib_EDFTask **items; // 堆数组
+    uint32_t count;           // 元素数
+    uint32_t key_offset;      // 排序键在任务结构体中的偏移
+} TimerLib_EDFHeap;
+
+/**
+ * @brief EDF调度器
+ */
+typedef struct {
+    TimerLib_EDFHeap ready;   // 已释放的作业，按截止期排序
+    TimerLib_EDFHeap waiting; // 未释放的作业，按释放时刻排序
+    uint32_t capacity;        // 每个堆的容量
+    uint32_t runs;            // 总执行次数
+    uint32_t misses;          // 总错过截止期次数
+} TimerLib_EDF;
+
+/**
+ * @brief 初始化调度器
+ * @param sched 调度器指针
+ * @param ready_buf 就绪堆数组
+ * @param waiting_buf 等待堆数组
+ * @param capacity 每个数组的容量(任务数上限)
+ */
+void TimerLib_EDF_Init(TimerLib_EDF *sched, TimerLib_EDFTask **ready_buf, TimerLib_EDFTask **waiting_buf,
+                       uint32_t capacity);
+
+/**
+ * @brief 添加任务
+ * @param sched 调度器指针
+ * @param task 任务指针，fn/ctx需预先设置
+ * @param period_us 周期(微秒)，0表示单次任务
+ * @param deadline_us 相对截止期(微秒)，0表示等于周期；单次任务必须指定
+ * @param offset_us 首次释放相对当前时刻的偏移(微秒)
+ * @return 0表示成功，-1表示调度器已满或单次任务未指定截止期
+ */
+int TimerLib_EDF_Add(TimerLib_EDF *sched, TimerLib_EDFTask *task, uint32_t period_us, uint32_t deadline_us,
+                     uint32_t offset_us);
+
+/**
+ * @brief 执行截止期最早的一个已释放作业
+ * @param sched 调度器指针
+ * @return true表示执行了一个作业，false表示当前没有已释放的作业
+ */
+bool TimerLib_EDF_RunOnce(TimerLib_EDF *sched);
+
+/**
+ * @brief 获取下一个作业的释放时刻，可用于空闲时休眠
+ * @param sched 调度器指针
+ * @return 下一个释放时刻(tick)，存在已释放作业时返回0，无任务时返回UINT64_MAX
+ */
+uint64_t TimerLib_EDF_NextRelease(const TimerLib_EDF *sched);
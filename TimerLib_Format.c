@@ -0,0 +1,340 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file TimerLib_Format.c
+ * @brief 无除法时间格式化实现
+ */
+#include "TimerLib_Format.h"
+
+/**
+ * @brief tick数拆分为整秒和秒内纳秒(均截断, 精确)
+ */
+static uint64_t split_ticks(uint64_t ticks, uint32_t *subsec_ns)
+{
+    uint32_t rem;
+    uint64_t seconds = TimerLib_SplitSeconds(ticks, &rem);
+
+    // rem*1e9个tick所含的整秒数即为rem个tick对应的纳秒数; rem < freq <= 2^32, rem*1e9 < 2^62
+    *subsec_ns = (uint32_t)TimerLib_SplitSeconds((uint64_t)rem * 1000000000, &rem);
+    return seconds;
+}
+
+/**
+ * @brief 生成32位数的十进制数字串(无前导零), 返回位数
+ */
+static uint32_t gen_digits32(char *out, uint32_t value)
+{
+    char tmp[10];
+    uint32_t n = 0;
+    uint32_t i;
+
+    do
+    {
+        uint32_t q = (uint32_t)(((uint64_t)value * 0xCCCCCCCDull) >> 35); // value/10, 对32位数精确
+
+        tmp[n++] = (char)('0' + value - q * 10);
+        value = q;
+    } while (value != 0);
+
+    for (i = 0; i < n; i++)
+    {
+        out[i] = tmp[n - 1 - i];
+    }
+    return n;
+}
+
+/**
+ * @brief 生成固定位数的数字串(含前导零)
+ */
+static void gen_digits_fixed(char *out, uint32_t value, uint32_t width)
+{
+    uint32_t i;
+
+    for (i = width; i-- > 0;)
+    {
+        uint32_t q = (uint32_t)(((uint64_t)value * 0xCCCCCCCDull) >> 35);
+
+        out[i] = (char)('0' + value - q * 10);
+        value = q;
+    }
+}
+
+/**
+ * @brief 64位数除以10^4, 按16位分段做长除法, 每段被除数小于2^30, 只用32位乘法, 返回余数
+ */
+static uint32_t div10000(uint64_t *value)
+{
+    uint64_t q = 0;
+    uint32_t r = 0;
+    int shift;
+
+    for (shift = 48; shift >= 0; shift -= 16)
+    {
+        uint32_t cur = (r << 16) | (uint32_t)((*value >> shift) & 0xFFFF);
+        uint32_t d = (uint32_t)(((uint64_t)cur * 0xD1B71759ull) >> 45); // cur/10000, 对32位数精确
+
+        r = cur - d * 10000;
+        q = (q << 16) | d;
+    }
+    *value = q;
+    return r;
+}
+
+/**
+ * @brief 64位数除以60, 按16位分段做长除法, 每段被除数小于2^22, 只用32位乘法, 返回余数
+ */
+static uint32_t div60(uint64_t *value)
+{
+    uint64_t q = 0;
+    uint32_t r = 0;
+    int shift;
+
+    for (shift = 48; shift >= 0; shift -= 16)
+    {
+        uint32_t cur = (r << 16) | (uint32_t)((*value >> shift) & 0xFFFF);
+        uint32_t d = (uint32_t)(((uint64_t)cur * 0x88888889ull) >> 37); // cur/60, 对32位数精确
+
+        r = cur - d * 60;
+        q = (q << 16) | d;
+    }
+    *value = q;
+    return r;
+}
+
+/**
+ * @brief 生成64位数的十进制数字串(无前导零), 高位按10^4分段, 返回位数
+ */
+static uint32_t gen_digits(char *out, uint64_t value)
+{
+    uint32_t groups[3]; // 2^64 / 10^12 < 2^32, 至多分出3段
+    uint32_t k = 0;
+    uint32_t n;
+
+    while (value >= ((uint64_t)1 << 32))
+    {
+        groups[k++] = div10000(&value);
+    }
+    n = gen_digits32(out, (uint32_t)value);
+    while (k-- > 0)
+    {
+        gen_digits_fixed(&out[n], groups[k], 4);
+        n += 4;
+    }
+    return n;
+}
+
+/**
+ * @brief 生成 整秒*10^9+秒内纳秒 的数字串, 返回位数
+ */
+static uint32_t gen_ns_digits(char *out, uint64_t seconds, uint32_t subsec_ns)
+{
+    uint32_t n;
+
+    if (seconds == 0)
+    {
+        return gen_digits32(out, subsec_ns);
+    }
+    n = gen_digits(out, seconds);
+    gen_digits_fixed(&out[n], subsec_ns, 9);
+    return n + 9;
+}
+
+/**
+ * @brief 带截断的输出缓冲区
+ */
+typedef struct
+{
+    char *buf;
+    uint32_t size;
+    uint32_t len;
+} Out;
+
+static void out_chars(Out *o, const char *s, uint32_t n)
+{
+    while (n-- > 0)
+    {
+        if (o->len + 1 < o->size)
+        {
+            o->buf[o->len++] = *s;
+        }
+        s++;
+    }
+}
+
+static void out_str(Out *o, const char *s)
+{
+    while (*s != '\0')
+    {
+        out_chars(o, s++, 1);
+    }
+}
+
+static uint32_t out_end(Out *o)
+{
+    if (o->size != 0)
+    {
+        o->buf[o->len] = '\0';
+    }
+    return o->len;
+}
+
+/**
+ * @brief 输出数字串表示的数 / 10^scale, 保留decimals位小数(截断)
+ */
+static void out_fixed(Out *o, const char *src, uint32_t n, uint32_t scale, uint32_t decimals)
+{
+    char digits[20 + 9 + 1];
+    uint32_t pad = (n <= scale) ? scale + 1 - n : 0;
+    uint32_t int_len;
+    uint32_t i;
+
+    // 位数不足时补前导零, 使整数部分至少一位
+    for (i = 0; i < pad; i++)
+    {
+        digits[i] = '0';
+    }
+    for (i = 0; i < n; i++)
+    {
+        digits[pad + i] = src[i];
+    }
+    n += pad;
+
+    int_len = n - scale;
+    out_chars(o, digits, int_len);
+    if (decimals > 0)
+    {
+        out_chars(o, ".", 1);
+        out_chars(o, &digits[int_len], (decimals < scale) ? decimals : scale);
+    }
+}
+
+/**
+ * @brief 输出两位数(0~59)
+ */
+static void out_2digits(Out *o, uint32_t v)
+{
+    char d[2];
+    uint32_t tens = (v * 205) >> 11; // v/10, 对0~99精确
+
+    d[0] = (char)('0' + tens);
+    d[1] = (char)('0' + v - tens * 10);
+    out_chars(o, d, 2);
+}
+
+uint32_t TimerLib_Format_U64(char *buf, uint32_t size, uint64_t value)
+{
+    Out o = {buf, size, 0};
+    char digits[20];
+
+    out_chars(&o, digits, gen_digits(digits, value));
+    return out_end(&o);
+}
+
+uint32_t TimerLib_Format_Duration(char *buf, uint32_t size, uint64_t ticks)
+{
+    Out o = {buf, size, 0};
+    char digits[20 + 9];
+    uint32_t subsec_ns;
+    uint64_t seconds = split_ticks(ticks, &subsec_ns);
+    uint32_t n;
+
+    if (seconds < 60)
+    {
+        n = gen_ns_digits(digits, seconds, subsec_ns);
+        if (seconds == 0 && subsec_ns < 1000)
+        {
+            out_fixed(&o, digits, n, 0, 0);
+            out_str(&o, "ns");
+        }
+        else if (seconds == 0 && subsec_ns < 1000000)
+        {
+            out_fixed(&o, digits, n, 3, 3);
+            out_str(&o, "us");
+        }
+        else if (seconds == 0)
+        {
+            out_fixed(&o, digits, n, 6, 3);
+            out_str(&o, "ms");
+        }
+        else
+        {
+            out_fixed(&o, digits, n, 9, 3);
+            out_str(&o, "s");
+        }
+    }
+    else
+    {
+        uint64_t minutes, hours;
+
+        if (seconds < ((uint64_t)1 << 32))
+        {
+            minutes = (seconds * 0x88888889ull) >> 37; // seconds/60, 对32位数精确
+            hours = (minutes * 0x88888889ull) >> 37;
+        }
+        else
+        {
+            // 超过136年, 分钟数可能超过32位, 分段长除避免调用64位除法库函数
+            minutes = seconds;
+            (void)div60(&minutes);
+            hours = minutes;
+            (void)div60(&hours);
+        }
+
+        if (hours > 0)
+        {
+            n = gen_digits(digits, hours);
+            out_chars(&o, digits, n);
+            out_str(&o, "h");
+            out_2digits(&o, (uint32_t)(minutes - hours * 60));
+        }
+        else
+        {
+            n = gen_digits32(digits, (uint32_t)minutes);
+            out_chars(&o, digits, n);
+        }
+        out_str(&o, "m");
+        out_2digits(&o, (uint32_t)(seconds - minutes * 60));
+        out_str(&o, "s");
+    }
+    return out_end(&o);
+}
+
+uint32_t TimerLib_Format_Seconds(char *buf, uint32_t size, uint64_t ticks, uint32_t decimals)
+{
+    Out o = {buf, size, 0};
+    char digits[20 + 9];
+    uint32_t subsec_ns;
+    uint64_t seconds = split_ticks(ticks, &subsec_ns);
+    uint32_t n = gen_digits(digits, seconds);
+
+    out_chars(&o, digits, n);
+    if (decimals > 0)
+    {
+        gen_digits_fixed(digits, subsec_ns, 9);
+        out_chars(&o, ".", 1);
+        out_chars(&o, digits, (decimals > 9) ? 9 : decimals);
+    }
+    return out_end(&o);
+}
@@ -0,0 +1,73 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* TimerLib_Format.h */
+#pragma once
+#include "TimerLib.h"
+
+/*
+ * 无除法、无动态内存的时间格式化
+ *
+ * tick数由TimerLib_SplitSeconds拆分为整秒和秒内纳秒(倒数乘法由余数校正，结果精确)，
+ * 十进制数字由乘法倒数逐位生成，单位换算只是在数字串中插入小数点，不依赖printf:
+ *
+ *   char buf[TIMERLIB_FORMAT_MAX];
+ *   TimerLib_Format_Duration(buf, sizeof(buf), ticks);  // "12.345ms"
+ *   TimerLib_Format_Seconds(buf, sizeof(buf), ticks, 6); // "0.012345"
+ *
+ * 所有函数按截断取值(不四舍五入)，返回写入的字符数(不含结束符)，
+ * 缓冲区不足时截断并保证以'\0'结尾。
+ */
+
+#define TIMERLIB_FORMAT_MAX 32 // 足够容纳任意输出的缓冲区大小
+
+/**
+ * @brief 格式化无符号整数
+ * @param buf 输出缓冲区
+ * @param size 缓冲区大小
+ * @param value 数值
+ * @return 写入的字符数
+ */
+uint32_t TimerLib_Format_U64(char *buf, uint32_t size, uint64_t value);
+
+/**
+ * @brief 将tick数格式化为带单位的时长，按大小选择单位
+ * @param buf 输出缓冲区
+ * @param size 缓冲区大小
+ * @param ticks 时长(tick)
+ * @return 写入的字符数
+ * @note 小于1us为"850ns"，小于1s为"12.345us"/"12.345ms"，小于1分钟为"12.345s"，
+ *       更长为"1h02m03s"/"2m03s"
+ */
+uint32_t TimerLib_Format_Duration(char *buf, uint32_t size, uint64_t ticks);
+
+/**
+ * @brief 将tick数格式化为定点秒数
+ * @param buf 输出缓冲区
+ * @param size 缓冲区大小
+ * @param ticks 时长或时间戳(tick)
+ * @param decimals 小数位数(0~9)
+ * @return 写入的字符数
+ */
+uint32_t TimerLib_Format_Seconds(char *buf, uint32_t size, uint64_t ticks, uint32_t decimals);
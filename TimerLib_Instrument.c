@@ -0,0 +1,252 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file TimerLib_Instrument.c
+ * @brief -finstrument-functions 钩子实现，按函数地址累计原始tick
+ * @note 本文件不可使用 -finstrument-functions 编译
+ */
+#include "TimerLib_Instrument.h"
+
+#define NO_INSTR __attribute__((no_instrument_function))
+
+/**
+ * @brief 函数统计表项
+ */
+typedef struct
+{
+    uintptr_t fn;    // 函数地址，0表示空位
+    bool excluded;   // 是否被排除
+    uint32_t calls;  // 调用次数
+    uint64_t ticks;  // 累计耗时(包含子函数)
+    uint64_t self;   // 累计自身耗时(扣除已记录的子函数)
+} InstrEntry;
+
+/**
+ * @brief 调用栈帧
+ */
+typedef struct
+{
+    InstrEntry *entry; // 对应统计表项，NULL表示不记录
+    uint64_t start;    // 进入时的tick
+    uint64_t child;    // 已记录的子函数耗时之和
+} InstrFrame;
+
+static InstrEntry table[TIMERLIB_INSTR_TABLE_SIZE];
+static InstrFrame stack[TIMERLIB_INSTR_STACK_DEPTH];
+static uint32_t depth;      // 当前调用深度(可能超过栈容量)，停止记录期间也保持跟踪
+static uint32_t dropped;    // 丢弃的记录数
+static volatile bool enabled;
+static bool in_hook;        // 防止钩子重入
+
+static struct
+{
+    uintptr_t start;
+    uintptr_t end;
+} exclude[TIMERLIB_INSTR_MAX_EXCLUDE];
+static uint32_t exclude_count;
+
+NO_INSTR static bool is_excluded(uintptr_t fn)
+{
+    for (uint32_t i = 0; i < exclude_count; i++)
+    {
+        if (fn >= exclude[i].start && fn < exclude[i].end)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+NO_INSTR static InstrEntry *lookup(uintptr_t fn)
+{
+    // 乘法散列，函数地址低位通常为对齐位
+    uint32_t idx = ((uint32_t)(fn >> 1) * 2654435761u) & (TIMERLIB_INSTR_TABLE_SIZE - 1);
+
+    for (uint32_t n = 0; n < TIMERLIB_INSTR_TABLE_SIZE; n++)
+    {
+        InstrEntry *e = &table[idx];
+
+        if (e->fn == fn)
+        {
+            return e;
+        }
+        if (e->fn == 0)
+        {
+            // 首次出现时检查排除表，之后热路径只需判断标志
+            e->fn = fn;
+            e->excluded = is_excluded(fn);
+            return e;
+        }
+        idx = (idx + 1) & (TIMERLIB_INSTR_TABLE_SIZE - 1);
+    }
+    return 0;
+}
+
+NO_INSTR void __cyg_profile_func_enter(void *this_fn, void *call_site)
+{
+    InstrEntry *e;
+    uint32_t d;
+
+    (void)call_site;
+    if (in_hook)
+    {
+        return;
+    }
+    in_hook = true;
+
+    // 停止记录时也压栈, 使进入与退出始终配对, 重新使能后不会错位
+    d = depth++;
+    if (d < TIMERLIB_INSTR_STACK_DEPTH)
+    {
+        e = 0;
+        if (enabled)
+        {
+            e = lookup((uintptr_t)this_fn);
+            if (e == 0)
+            {
+                dropped++;
+            }
+            else if (e->excluded)
+            {
+                e = 0;
+            }
+        }
+        stack[d].entry = e;
+        stack[d].child = 0;
+        if (e != 0)
+        {
+            stack[d].start = TimerLib_GetTimestamp_tick();
+        }
+    }
+    else if (enabled)
+    {
+        dropped++;
+    }
+
+    in_hook = false;
+}
+
+NO_INSTR void __cyg_profile_func_exit(void *this_fn, void *call_site)
+{
+    uint64_t spent;
+    InstrFrame *f;
+
+    (void)this_fn;
+    (void)call_site;
+    if (in_hook || depth == 0)
+    {
+        return;
+    }
+    in_hook = true;
+
+    depth--;
+    if (depth < TIMERLIB_INSTR_STACK_DEPTH)
+    {
+        f = &stack[depth];
+        if (f->entry != 0 && enabled)
+        {
+            spent = TimerLib_GetTimestamp_tick() - f->start;
+            f->entry->calls++;
+            f->entry->ticks += spent;
+            f->entry->self += spent - f->child;
+        }
+        else
+        {
+            // 未记录的函数(排除、表满或停止记录)自身耗时归入调用者, 其子函数的耗时继续向上传递
+            spent = f->child;
+        }
+        if (depth > 0)
+        {
+            stack[depth - 1].child += spent;
+        }
+    }
+
+    in_hook = false;
+}
+
+NO_INSTR void TimerLib_Instr_Enable(bool enable)
+{
+    enabled = enable;
+}
+
+NO_INSTR void TimerLib_Instr_Reset(void)
+{
+    bool was_enabled = enabled;
+
+    enabled = false;
+    for (uint32_t i = 0; i < TIMERLIB_INSTR_TABLE_SIZE; i++)
+    {
+        table[i].fn = 0;
+        table[i].excluded = false;
+        table[i].calls = 0;
+        table[i].ticks = 0;
+        table[i].self = 0;
+    }
+    // 调用深度保持不变, 尚未返回的函数不再记录
+    for (uint32_t i = 0; i < TIMERLIB_INSTR_STACK_DEPTH; i++)
+    {
+        stack[i].entry = 0;
+        stack[i].child = 0;
+    }
+    dropped = 0;
+    enabled = was_enabled;
+}
+
+NO_INSTR int TimerLib_Instr_Exclude(const void *start, const void *end)
+{
+    if (exclude_count >= TIMERLIB_INSTR_MAX_EXCLUDE)
+    {
+        return -1;
+    }
+    exclude[exclude_count].start = (uintptr_t)start;
+    exclude[exclude_count].end = (uintptr_t)end;
+    exclude_count++;
+
+    // 已登记的函数也需要重新判断
+    for (uint32_t i = 0; i < TIMERLIB_INSTR_TABLE_SIZE; i++)
+    {
+        if (table[i].fn != 0)
+        {
+            table[i].excluded = is_excluded(table[i].fn);
+        }
+    }
+    return 0;
+}
+
+NO_INSTR uint32_t TimerLib_Instr_GetDropped(void)
+{
+    return dropped;
+}
+
+NO_INSTR void TimerLib_Instr_Dump(TimerLib_InstrCallback cb, void *ctx)
+{
+    for (uint32_t i = 0; i < TIMERLIB_INSTR_TABLE_SIZE; i++)
+    {
+        if (table[i].fn != 0 && !table[i].excluded && table[i].calls != 0)
+        {
+            cb((void *)table[i].fn, table[i].calls, table[i].ticks, table[i].self, ctx);
+        }
+    }
+}
@@ -0,0 +1,94 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* TimerLib_Instrument.h */
+#pragma once
+#include "TimerLib.h"
+
+/*
+ * -finstrument-functions 自动函数计时
+ *
+ * 使用 -finstrument-functions 编译需要统计的源文件，编译器会在每个函数
+ * 入口/出口调用 __cyg_profile_func_enter/exit，本模块在其中记录原始tick，
+ * 按函数地址累计调用次数、包含子函数的耗时与自身耗时。
+ * 递归函数的包含耗时会重复累计各层，自身耗时不受影响。
+ *
+ * TimerLib 自身的源文件必须排除在插桩之外，例如:
+ *   -finstrument-functions -finstrument-functions-exclude-file-list=TimerLib
+ */
+
+#ifndef TIMERLIB_INSTR_TABLE_SIZE
+#define TIMERLIB_INSTR_TABLE_SIZE 256 // 函数统计表容量，必须为2的幂
+#endif
+
+#ifndef TIMERLIB_INSTR_STACK_DEPTH
+#define TIMERLIB_INSTR_STACK_DEPTH 32 // 最大调用嵌套深度
+#endif
+
+#ifndef TIMERLIB_INSTR_MAX_EXCLUDE
+#define TIMERLIB_INSTR_MAX_EXCLUDE 8 // 最大排除地址区间数
+#endif
+
+/**
+ * @brief 函数统计回调
+ * @param fn 函数地址
+ * @param calls 调用次数
+ * @param ticks 累计耗时(tick，包含子函数)
+ * @param self_ticks 累计自身耗时(tick，扣除已记录的子函数，未记录的子函数计入调用者)
+ * @param ctx 用户上下文
+ */
+typedef void (*TimerLib_InstrCallback)(void *fn, uint32_t calls, uint64_t ticks, uint64_t self_ticks, void *ctx);
+
+/**
+ * @brief 使能或停止记录
+ * @param enable true开始记录，false停止记录
+ * @note 停止期间仍跟踪调用深度；使能前已进入、使能后才返回的函数不记录
+ */
+void TimerLib_Instr_Enable(bool enable);
+
+/**
+ * @brief 清空统计表，尚未返回的函数不再记录
+ */
+void TimerLib_Instr_Reset(void);
+
+/**
+ * @brief 排除一段地址区间内的函数，不再记录
+ * @param start 起始地址(包含)
+ * @param end 结束地址(不包含)
+ * @return 0表示成功，-1表示排除表已满
+ */
+int TimerLib_Instr_Exclude(const void *start, const void *end);
+
+/**
+ * @brief 获取因统计表已满或调用栈溢出而丢弃的记录数
+ * @return 丢弃的记录数
+ */
+uint32_t TimerLib_Instr_GetDropped(void);
+
+/**
+ * @brief 遍历统计表，输出每个函数的统计值
+ * @param cb 统计回调
+ * @param ctx 用户上下文
+ */
+void TimerLib_Instr_Dump(TimerLib_InstrCallback cb, void *ctx);
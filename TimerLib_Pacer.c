@@ -0,0 +1,112 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file TimerLib_Pacer.c
+ * @brief 固定频率循环节拍器实现
+ */
+#include "TimerLib_Pacer.h"
+
+/**
+ * @brief 周期起点前进n个周期, 小数部分累计进位, 长期平均周期等于period_us换算的精确值
+ */
+static void advance(TimerLib_Pacer *pacer, uint64_t n)
+{
+    uint64_t frac = pacer->frac_acc + n * pacer->period_frac;
+
+    pacer->deadline += n * pacer->period_ticks + frac / 1000000;
+    pacer->frac_acc = (uint32_t)(frac % 1000000);
+}
+
+void TimerLib_Pacer_Init(TimerLib_Pacer *pacer, uint32_t period_us, TimerLib_PacerPolicy policy)
+{
+    uint64_t period = (uint64_t)period_us * TimerLib_GetClockFreq();
+
+    // 周期 = period_us * freq / 1e6 tick, 整数部分与小数部分分开保存
+    pacer->period_ticks = (uint32_t)(period / 1000000);
+    pacer->period_frac = (uint32_t)(period % 1000000);
+    if (pacer->period_ticks == 0)
+    {
+        pacer->period_ticks = 1;
+        pacer->period_frac = 0;
+    }
+    pacer->frac_acc = 0;
+    pacer->policy = policy;
+    pacer->deadline = TimerLib_GetTimestamp_tick();
+    advance(pacer, 1);
+
+    pacer->iterations = 0;
+    pacer->overruns = 0;
+    pacer->skipped = 0;
+    pacer->jitter_min = UINT32_MAX;
+    pacer->jitter_max = 0;
+    pacer->jitter_sum = 0;
+}
+
+bool TimerLib_Pacer_Wait(TimerLib_Pacer *pacer)
+{
+    uint64_t now = TimerLib_GetTimestamp_tick();
+    uint32_t jitter;
+    bool overrun = (now > pacer->deadline);
+
+    if (overrun)
+    {
+        pacer->overruns++;
+        if (pacer->policy == TIMERLIB_PACER_SKIP)
+        {
+            // 前进到第一个未来的周期起点，仍保持在原周期网格上
+            uint64_t late = now - pacer->deadline;
+            uint64_t missed = late / pacer->period_ticks + 1;
+
+            // 含小数部分时按精确周期计算: 满足 frac_acc + n * 周期 >= (late + 1) * 1e6 的最小n
+            if (pacer->period_frac != 0 && late < UINT64_MAX / 1000000 - ((uint64_t)pacer->period_ticks + 2))
+            {
+                uint64_t period = (uint64_t)pacer->period_ticks * 1000000 + pacer->period_frac;
+
+                missed = ((late + 1) * 1000000 - pacer->frac_acc + period - 1) / period;
+            }
+
+            pacer->skipped += (uint32_t)missed;
+            advance(pacer, missed);
+        }
+    }
+
+    TimerLib_DelayUntil_tick(pacer->deadline);
+    now = TimerLib_GetTimestamp_tick();
+
+    jitter = (uint32_t)(now - pacer->deadline);
+    if (jitter < pacer->jitter_min)
+    {
+        pacer->jitter_min = jitter;
+    }
+    if (jitter > pacer->jitter_max)
+    {
+        pacer->jitter_max = jitter;
+    }
+    pacer->jitter_sum += jitter;
+
+    advance(pacer, 1);
+    pacer->iterations++;
+    return overrun;
+}
@@ -0,0 +1,83 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* TimerLib_Pacer.h */
+#pragma once
+#include "TimerLib.h"
+
+/*
+ * 固定频率循环节拍器
+ *
+ * 以绝对tick时刻作为每个周期的起点，每次精确前进一个周期，不受工作
+ * 耗时和延时函数调用开销影响，因此不会累积漂移:
+ *
+ *   TimerLib_Pacer pacer;
+ *   TimerLib_Pacer_Init(&pacer, 1000, TIMERLIB_PACER_SKIP);
+ *   while (1)
+ *   {
+ *       TimerLib_Pacer_Wait(&pacer);
+ *       control_step();
+ *   }
+ */
+
+/**
+ * @brief 超时处理策略
+ */
+typedef enum {
+    TIMERLIB_PACER_SKIP,    // 丢弃错过的周期，等待下一个未来的周期起点
+    TIMERLIB_PACER_CATCHUP, // 立即开始，后续周期连续执行直到追上
+} TimerLib_PacerPolicy;
+
+/**
+ * @brief 节拍器
+ */
+typedef struct {
+    uint64_t deadline;           // 下一个周期的起点(tick)
+    uint32_t period_ticks;       // 周期的整数部分(tick)
+    uint32_t period_frac;        // 周期的小数部分(百万分之一tick)
+    uint32_t frac_acc;           // 小数部分累计值, 满一百万进一个tick
+    TimerLib_PacerPolicy policy; // 超时处理策略
+
+    uint32_t iterations; // 已执行周期数
+    uint32_t overruns;   // 超时次数(调用Wait时已过周期起点)
+    uint32_t skipped;    // SKIP策略下丢弃的周期数
+    uint32_t jitter_min; // 周期启动抖动最小值(tick)
+    uint32_t jitter_max; // 周期启动抖动最大值(tick)
+    uint64_t jitter_sum; // 周期启动抖动累计值(tick)
+} TimerLib_Pacer;
+
+/**
+ * @brief 初始化节拍器，第一个周期起点为当前时刻加一个周期
+ * @param pacer 节拍器指针
+ * @param period_us 周期(微秒)
+ * @param policy 超时处理策略
+ */
+void TimerLib_Pacer_Init(TimerLib_Pacer *pacer, uint32_t period_us, TimerLib_PacerPolicy policy);
+
+/**
+ * @brief 等待下一个周期起点
+ * @param pacer 节拍器指针
+ * @return true表示本周期超时
+ */
+bool TimerLib_Pacer_Wait(TimerLib_Pacer *pacer);
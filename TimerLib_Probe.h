@@ -0,0 +1,155 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* TimerLib_Probe.h */
+#pragma once
+#include "TimerLib.h"
+
+/*
+ * 常驻计时探针
+ *
+ * 探针模式在编译时通过 TIMERLIB_PROBE_MODE 选择:
+ *   TIMERLIB_PROBE_OFF     所有宏展开为空，不产生任何代码和数据(默认)
+ *   TIMERLIB_PROBE_SAMPLED 每 TIMERLIB_PROBE_SAMPLE_RATE 次执行采样一次，
+ *                          未采样时仅有一次递减和一次分支
+ *   TIMERLIB_PROBE_FULL    每次执行都记录原始tick
+ *
+ * 用法:
+ *   TIMERLIB_PROBE_DEFINE(adc_isr);      // 文件作用域定义探针槽
+ *   TIMERLIB_PROBE_BEGIN(adc_isr);
+ *   process_adc();
+ *   TIMERLIB_PROBE_END(adc_isr);
+ *   TIMERLIB_PROBE_EVENT(adc_isr);        // 仅记录事件发生时刻
+ *
+ * 区间(BEGIN/END)与事件(EVENT)分别计数和采样，同一探针槽可以同时用于两者。
+ * OFF模式下TIMERLIB_PROBE_SLOT为NULL，读取统计前需判断。
+ */
+#define TIMERLIB_PROBE_OFF 0
+#define TIMERLIB_PROBE_SAMPLED 1
+#define TIMERLIB_PROBE_FULL 2
+
+#ifndef TIMERLIB_PROBE_MODE
+#define TIMERLIB_PROBE_MODE TIMERLIB_PROBE_OFF
+#endif
+
+#ifndef TIMERLIB_PROBE_SAMPLE_RATE
+#define TIMERLIB_PROBE_SAMPLE_RATE 64
+#endif
+
+/**
+ * @brief 探针槽结构体，每个探针一个静态实例
+ */
+typedef struct {
+    uint64_t start;       // BEGIN时的tick
+    uint64_t last;        // 最近一次EVENT的tick
+    uint64_t sum_ticks;   // 区间tick累计值
+    uint32_t count;       // 区间记录次数(采样模式下为采样次数)
+    uint32_t min_ticks;   // 最短区间(tick)
+    uint32_t max_ticks;   // 最长区间(tick)
+    uint32_t skip;        // 采样模式下距下一次区间采样的剩余次数
+    uint32_t event_count; // 事件记录次数(采样模式下为采样次数)
+    uint32_t event_skip;  // 采样模式下距下一次事件采样的剩余次数
+    bool armed;           // 本次BEGIN是否被采样
+} TimerLib_ProbeSlot;
+
+#if TIMERLIB_PROBE_MODE == TIMERLIB_PROBE_OFF
+
+#define TIMERLIB_PROBE_DEFINE(name) typedef int timerlib_probe_unused_##name
+#define TIMERLIB_PROBE_BEGIN(name) ((void)0)
+#define TIMERLIB_PROBE_END(name) ((void)0)
+#define TIMERLIB_PROBE_EVENT(name) ((void)0)
+#define TIMERLIB_PROBE_SLOT(name) ((const TimerLib_ProbeSlot *)0)
+
+#else
+
+#define TIMERLIB_PROBE_DEFINE(name) \
+    static TimerLib_ProbeSlot timerlib_probe_##name = {0, 0, 0, 0, UINT32_MAX, 0, 0, 0, 0, false}
+#define TIMERLIB_PROBE_BEGIN(name) TimerLib_ProbeBegin(&timerlib_probe_##name)
+#define TIMERLIB_PROBE_END(name) TimerLib_ProbeEnd(&timerlib_probe_##name)
+#define TIMERLIB_PROBE_EVENT(name) TimerLib_ProbeEvent(&timerlib_probe_##name)
+#define TIMERLIB_PROBE_SLOT(name) ((const TimerLib_ProbeSlot *)&timerlib_probe_##name)
+
+/**
+ * @brief 判断本次执行是否需要采样
+ * @param skip 距下一次采样的剩余次数(区间与事件各自一个)
+ * @return true表示需要采样
+ */
+__attribute__((always_inline)) static inline bool TimerLib_ProbeSample(uint32_t *skip)
+{
+#if TIMERLIB_PROBE_MODE == TIMERLIB_PROBE_SAMPLED
+    if (*skip != 0)
+    {
+        (*skip)--;
+        return false;
+    }
+    *skip = TIMERLIB_PROBE_SAMPLE_RATE - 1;
+#else
+    (void)skip;
+#endif
+    return true;
+}
+
+__attribute__((always_inline)) static inline void TimerLib_ProbeBegin(TimerLib_ProbeSlot *slot)
+{
+    slot->armed = TimerLib_ProbeSample(&slot->skip);
+    if (slot->armed)
+    {
+        slot->start = TimerLib_GetTimestamp_tick();
+    }
+}
+
+__attribute__((always_inline)) static inline void TimerLib_ProbeEnd(TimerLib_ProbeSlot *slot)
+{
+    uint32_t ticks;
+
+    if (!slot->armed)
+    {
+        return;
+    }
+    slot->armed = false;
+
+    ticks = (uint32_t)(TimerLib_GetTimestamp_tick() - slot->start);
+
+    slot->count++;
+    slot->sum_ticks += ticks;
+    if (ticks < slot->min_ticks)
+    {
+        slot->min_ticks = ticks;
+    }
+    if (ticks > slot->max_ticks)
+    {
+        slot->max_ticks = ticks;
+    }
+}
+
+__attribute__((always_inline)) static inline void TimerLib_ProbeEvent(TimerLib_ProbeSlot *slot)
+{
+    if (TimerLib_ProbeSample(&slot->event_skip))
+    {
+        slot->last = TimerLib_GetTimestamp_tick();
+        slot->event_count++;
+    }
+}
+
+#endif
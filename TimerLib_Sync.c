@@ -0,0 +1,272 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file TimerLib_Sync.c
+ * @brief 节点间时钟同步实现
+ */
+#include "TimerLib_Sync.h"
+#include <stddef.h>
+
+enum
+{
+    SLAVE_IDLE,      // 等待Sync
+    SLAVE_GOT_SYNC,  // 已收到Sync, 等待Follow_Up
+    SLAVE_SENT_REQ,  // 已发送Delay_Req, 等待Delay_Resp
+};
+
+static bool sync_send(TimerLib_SyncTransport *transport, uint64_t (*clock)(void), TimerLib_SyncMsg *msg)
+{
+    msg->tx_tick = clock();
+    msg->rx_tick = 0;
+    return transport->send(transport->ctx, msg);
+}
+
+static bool sync_recv(TimerLib_SyncTransport *transport, uint64_t (*clock)(void), TimerLib_SyncMsg *msg)
+{
+    msg->rx_tick = 0;
+    if (!transport->recv(transport->ctx, msg))
+    {
+        return false;
+    }
+    if (msg->rx_tick == 0)
+    {
+        msg->rx_tick = clock();
+    }
+    return true;
+}
+
+void TimerLib_SyncMaster_Init(TimerLib_SyncMaster *master, TimerLib_SyncTransport transport,
+                              uint64_t (*clock)(void), uint32_t interval_us)
+{
+    master->transport = transport;
+    master->clock = (clock != NULL) ? clock : TimerLib_GetTimestamp_tick;
+    master->interval_ticks = (uint32_t)((uint64_t)interval_us * TimerLib_GetClockFreq() / 1000000);
+    master->next_sync = master->clock();
+    master->seq = 0;
+}
+
+void TimerLib_SyncMaster_Poll(TimerLib_SyncMaster *master)
+{
+    TimerLib_SyncMsg msg;
+    uint64_t now = master->clock();
+
+    if (now >= master->next_sync)
+    {
+        // 两步式: Sync发出后才知道实际发送时刻, 由Follow_Up携带
+        msg.type = TIMERLIB_SYNC_SYNC;
+        msg.seq = ++master->seq;
+        msg.origin = 0;
+        if (sync_send(&master->transport, master->clock, &msg))
+        {
+            msg.type = TIMERLIB_SYNC_FOLLOW_UP;
+            msg.origin = msg.tx_tick;
+            sync_send(&master->transport, master->clock, &msg);
+        }
+
+        master->next_sync += master->interval_ticks;
+        if (master->next_sync <= now)
+        {
+            master->next_sync = now + master->interval_ticks;
+        }
+    }
+
+    while (sync_recv(&master->transport, master->clock, &msg))
+    {
+        if (msg.type == TIMERLIB_SYNC_DELAY_REQ)
+        {
+            msg.type = TIMERLIB_SYNC_DELAY_RESP;
+            msg.origin = msg.rx_tick;
+            sync_send(&master->transport, master->clock, &msg);
+        }
+    }
+}
+
+void TimerLib_SyncSlave_Init(TimerLib_SyncSlave *slave, TimerLib_SyncTransport transport, uint64_t (*clock)(void))
+{
+    slave->transport = transport;
+    slave->clock = (clock != NULL) ? clock : TimerLib_GetTimestamp_tick;
+    slave->seq = 0;
+    slave->state = SLAVE_IDLE;
+
+    slave->valid = false;
+    slave->offset = 0;
+    slave->delay = 0;
+    slave->rounds = 0;
+    slave->offset_min = INT64_MAX;
+    slave->offset_max = INT64_MIN;
+    slave->offset_sum = 0;
+}
+
+bool TimerLib_SyncSlave_Poll(TimerLib_SyncSlave *slave)
+{
+    TimerLib_SyncMsg msg;
+    bool done = false;
+
+    while (sync_recv(&slave->transport, slave->clock, &msg))
+    {
+        if (msg.type == TIMERLIB_SYNC_SYNC)
+        {
+            // 新一轮开始, 放弃尚未完成的上一轮
+            slave->seq = msg.seq;
+            slave->t2 = msg.rx_tick;
+            slave->state = SLAVE_GOT_SYNC;
+        }
+        else if (msg.type == TIMERLIB_SYNC_FOLLOW_UP && msg.seq == slave->seq && slave->state == SLAVE_GOT_SYNC)
+        {
+            slave->t1 = msg.origin;
+            msg.type = TIMERLIB_SYNC_DELAY_REQ;
+            msg.origin = 0;
+            if (sync_send(&slave->transport, slave->clock, &msg))
+            {
+                slave->t3 = msg.tx_tick;
+                slave->state = SLAVE_SENT_REQ;
+            }
+            else
+            {
+                slave->state = SLAVE_IDLE;
+            }
+        }
+        else if (msg.type == TIMERLIB_SYNC_DELAY_RESP && msg.seq == slave->seq && slave->state == SLAVE_SENT_REQ)
+        {
+            int64_t ms = (int64_t)(slave->t2 - slave->t1);
+            int64_t sm = (int64_t)(msg.origin - slave->t3);
+
+            slave->offset = (ms - sm) / 2;
+            slave->delay = (ms + sm) / 2;
+            slave->state = SLAVE_IDLE;
+            slave->valid = true;
+
+            slave->rounds++;
+            if (slave->offset < slave->offset_min)
+            {
+                slave->offset_min = slave->offset;
+            }
+            if (slave->offset > slave->offset_max)
+            {
+                slave->offset_max = slave->offset;
+            }
+            slave->offset_sum += slave->offset;
+            done = true;
+        }
+    }
+
+    return done;
+}
+
+uint64_t TimerLib_SyncSlave_ToMaster(const TimerLib_SyncSlave *slave, uint64_t local)
+{
+    return local - (uint64_t)slave->offset;
+}
+
+static bool loop_send(void *ctx, TimerLib_SyncMsg *msg)
+{
+    TimerLib_SyncLink *link = ((TimerLib_SyncLoopEnd *)ctx)->tx;
+    uint32_t next = (link->tail + 1) % TIMERLIB_SYNC_LOOPBACK_DEPTH;
+    uint64_t due;
+
+    if (next == link->head)
+    {
+        link->dropped++;
+        return false;
+    }
+    due = TimerLib_GetTimestamp_tick() + link->latency_ticks;
+    if (link->jitter_ticks != 0)
+    {
+        // xorshift32
+        link->rng ^= link->rng << 13;
+        link->rng ^= link->rng >> 17;
+        link->rng ^= link->rng << 5;
+        due += link->rng % (link->jitter_ticks + 1);
+
+        // 先进先出: 不早于前一条消息到达
+        if (link->head != link->tail)
+        {
+            uint64_t prev = link->due[(link->tail + TIMERLIB_SYNC_LOOPBACK_DEPTH - 1) % TIMERLIB_SYNC_LOOPBACK_DEPTH];
+
+            if (due < prev)
+            {
+                due = prev;
+            }
+        }
+    }
+    link->msg[link->tail] = *msg;
+    link->due[link->tail] = due;
+    link->tail = next;
+    return true;
+}
+
+static bool loop_recv(void *ctx, TimerLib_SyncMsg *msg)
+{
+    TimerLib_SyncLink *link = ((TimerLib_SyncLoopEnd *)ctx)->rx;
+
+    // 链路先进先出, 队首未到达时后面的消息也未到达
+    if (link->head == link->tail || TimerLib_GetTimestamp_tick() < link->due[link->head])
+    {
+        return false;
+    }
+    *msg = link->msg[link->head];
+    link->head = (link->head + 1) % TIMERLIB_SYNC_LOOPBACK_DEPTH;
+    return true;
+}
+
+void TimerLib_SyncLoopback_Init(TimerLib_SyncLoopback *loop, uint32_t latency_01_ticks, uint32_t latency_10_ticks)
+{
+    uint32_t i;
+
+    for (i = 0; i < 2; i++)
+    {
+        loop->link[i].head = 0;
+        loop->link[i].tail = 0;
+        loop->link[i].jitter_ticks = 0;
+        loop->link[i].rng = 1;
+        loop->link[i].dropped = 0;
+    }
+    loop->link[0].latency_ticks = latency_01_ticks;
+    loop->link[1].latency_ticks = latency_10_ticks;
+
+    loop->end[0].tx = &loop->link[0];
+    loop->end[0].rx = &loop->link[1];
+    loop->end[1].tx = &loop->link[1];
+    loop->end[1].rx = &loop->link[0];
+}
+
+void TimerLib_SyncLoopback_SetJitter(TimerLib_SyncLoopback *loop, uint32_t jitter_ticks, uint32_t seed)
+{
+    uint32_t i;
+
+    for (i = 0; i < 2; i++)
+    {
+        loop->link[i].jitter_ticks = jitter_ticks;
+        // 两个方向使用不同的序列; xorshift状态不能为0
+        loop->link[i].rng = (seed ^ (i * 0x9E3779B9u)) | 1;
+    }
+}
+
+TimerLib_SyncTransport TimerLib_SyncLoopback_Transport(TimerLib_SyncLoopback *loop, uint32_t side)
+{
+    TimerLib_SyncTransport transport = {loop_send, loop_recv, &loop->end[side & 1]};
+
+    return transport;
+}
@@ -0,0 +1,200 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* TimerLib_Sync.h */
+#pragma once
+#include "TimerLib.h"
+
+/*
+ * 节点间时钟同步(两步式双向时间传递, 与PTP的Sync/Follow_Up/Delay_Req/Delay_Resp相同)
+ *
+ *   主节点            从节点
+ *   t1  ---Sync---->  t2
+ *       -Follow_Up(t1)->
+ *   t4  <-Delay_Req--  t3
+ *       -Delay_Resp(t4)->
+ *
+ *   offset = ((t2 - t1) - (t4 - t3)) / 2     从节点时钟减主节点时钟
+ *   delay  = ((t2 - t1) + (t4 - t3)) / 2     单向路径延迟
+ *
+ * 时间戳均为原始tick, 要求各节点定时器时钟频率相同。链路不对称时
+ * offset 的误差为两个方向延迟差的一半。
+ */
+
+#ifndef TIMERLIB_SYNC_LOOPBACK_DEPTH
+#define TIMERLIB_SYNC_LOOPBACK_DEPTH 8 // 回环传输每个方向的队列深度
+#endif
+
+/**
+ * @brief 同步消息类型
+ */
+typedef enum {
+    TIMERLIB_SYNC_SYNC,
+    TIMERLIB_SYNC_FOLLOW_UP,
+    TIMERLIB_SYNC_DELAY_REQ,
+    TIMERLIB_SYNC_DELAY_RESP,
+} TimerLib_SyncMsgType;
+
+/**
+ * @brief 同步消息
+ */
+typedef struct {
+    TimerLib_SyncMsgType type;
+    uint16_t seq;     // 序号, 用于匹配同一轮的消息
+    uint64_t origin;  // Follow_Up携带t1, Delay_Resp携带t4
+    uint64_t tx_tick; // 发送时刻, 发送前由同步代码填写, 支持硬件时间戳的传输可在send中改写
+    uint64_t rx_tick; // 接收时刻, 支持硬件时间戳的传输在recv中填写, 为0时由同步代码在收到时填写
+} TimerLib_SyncMsg;
+
+/**
+ * @brief 传输接口
+ */
+typedef struct {
+    bool (*send)(void *ctx, TimerLib_SyncMsg *msg); // 发送一条消息, 返回false表示发送失败
+    bool (*recv)(void *ctx, TimerLib_SyncMsg *msg); // 非阻塞接收一条消息, 没有消息时返回false
+    void *ctx;
+} TimerLib_SyncTransport;
+
+/**
+ * @brief 主节点
+ */
+typedef struct {
+    TimerLib_SyncTransport transport;
+    uint64_t (*clock)(void); // 本节点时钟
+    uint32_t interval_ticks; // Sync发送间隔
+    uint64_t next_sync;      // 下一次发送Sync的时刻
+    uint16_t seq;
+} TimerLib_SyncMaster;
+
+/**
+ * @brief 从节点
+ */
+typedef struct {
+    TimerLib_SyncTransport transport;
+    uint64_t (*clock)(void); // 本节点时钟
+    uint16_t seq;            // 当前一轮的序号
+    uint8_t state;           // 当前一轮已完成的步骤
+    uint64_t t1, t2, t3;
+
+    bool valid;         // 是否已完成至少一轮
+    int64_t offset;     // 最近一轮测得的偏移(从节点减主节点, tick)
+    int64_t delay;      // 最近一轮测得的单向路径延迟(tick)
+    uint32_t rounds;    // 完成的轮数
+    int64_t offset_min; // 偏移最小值
+    int64_t offset_max; // 偏移最大值
+    int64_t offset_sum; // 偏移累计值
+} TimerLib_SyncSlave;
+
+/**
+ * @brief 初始化主节点
+ * @param master 主节点指针
+ * @param transport 传输接口
+ * @param clock 本节点时钟, 为NULL时使用TimerLib_GetTimestamp_tick
+ * @param interval_us Sync发送间隔(微秒)
+ */
+void TimerLib_SyncMaster_Init(TimerLib_SyncMaster *master, TimerLib_SyncTransport transport,
+                              uint64_t (*clock)(void), uint32_t interval_us);
+
+/**
+ * @brief 主节点轮询: 到时发送Sync/Follow_Up, 应答收到的Delay_Req
+ * @param master 主节点指针
+ */
+void TimerLib_SyncMaster_Poll(TimerLib_SyncMaster *master);
+
+/**
+ * @brief 初始化从节点
+ * @param slave 从节点指针
+ * @param transport 传输接口
+ * @param clock 本节点时钟, 为NULL时使用TimerLib_GetTimestamp_tick
+ */
+void TimerLib_SyncSlave_Init(TimerLib_SyncSlave *slave, TimerLib_SyncTransport transport, uint64_t (*clock)(void));
+
+/**
+ * @brief 从节点轮询: 处理收到的消息
+ * @param slave 从节点指针
+ * @return true表示本次完成了一轮测量
+ */
+bool TimerLib_SyncSlave_Poll(TimerLib_SyncSlave *slave);
+
+/**
+ * @brief 将从节点时刻换算到主节点时间线
+ * @param slave 从节点指针
+ * @param local 从节点时刻(tick)
+ * @return 主节点时刻(tick)
+ */
+uint64_t TimerLib_SyncSlave_ToMaster(const TimerLib_SyncSlave *slave, uint64_t local);
+
+/**
+ * @brief 回环传输的单向链路
+ */
+typedef struct {
+    TimerLib_SyncMsg msg[TIMERLIB_SYNC_LOOPBACK_DEPTH];
+    uint64_t due[TIMERLIB_SYNC_LOOPBACK_DEPTH]; // 到达时刻
+    uint32_t head, tail;
+    uint32_t latency_ticks; // 链路延迟
+    uint32_t jitter_ticks;  // 每条消息额外的随机延迟上限, 0表示固定延迟
+    uint32_t rng;           // 抖动的伪随机数状态(xorshift32, 非0)
+    uint32_t dropped;       // 队列满丢弃的消息数
+} TimerLib_SyncLink;
+
+/**
+ * @brief 回环传输的一端
+ */
+typedef struct {
+    TimerLib_SyncLink *tx;
+    TimerLib_SyncLink *rx;
+} TimerLib_SyncLoopEnd;
+
+/**
+ * @brief 进程内回环传输, 用于在同一程序中测试主从节点
+ */
+typedef struct {
+    TimerLib_SyncLink link[2]; // [0]: 端0到端1, [1]: 端1到端0
+    TimerLib_SyncLoopEnd end[2];
+} TimerLib_SyncLoopback;
+
+/**
+ * @brief 初始化回环传输
+ * @param loop 回环传输指针
+ * @param latency_01_ticks 端0到端1的延迟(tick)
+ * @param latency_10_ticks 端1到端0的延迟(tick), 与上一参数不同即为链路不对称
+ */
+void TimerLib_SyncLoopback_Init(TimerLib_SyncLoopback *loop, uint32_t latency_01_ticks, uint32_t latency_10_ticks);
+
+/**
+ * @brief 设置回环传输的延迟抖动
+ * @param loop 回环传输指针
+ * @param jitter_ticks 每条消息在固定延迟之上额外的随机延迟上限(tick), 0表示关闭
+ * @param seed 伪随机数种子, 相同种子得到相同的延迟序列
+ * @note 链路保持先进先出, 抖动不会使消息乱序
+ */
+void TimerLib_SyncLoopback_SetJitter(TimerLib_SyncLoopback *loop, uint32_t jitter_ticks, uint32_t seed);
+
+/**
+ * @brief 获取回环传输一端的传输接口
+ * @param loop 回环传输指针
+ * @param side 0或1
+ * @return 传输接口
+ */
+TimerLib_SyncTransport TimerLib_SyncLoopback_Transport(TimerLib_SyncLoopback *loop, uint32_t side);
@@ -0,0 +1,85 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file TimerLib_UTC.c
+ * @brief 时间戳到UTC的映射实现
+ */
+#include "TimerLib_UTC.h"
+
+/*
+ * 双缓冲发布: AddReference在非当前缓冲区上拟合, 完成后递增utc_seq切换,
+ * 读取方在读取前后比较utc_seq, 变化说明读取期间发生了发布, 重新读取。
+ * 中断中读取时写入方不会在其间推进, 线程中读取被发布打断时重试一次即可,
+ * 两种情况都不会像单缓冲序号锁那样在中断中等待被打断的写入方。
+ */
+static TimerLib_ClockMap utc_map[2];
+static uint32_t utc_seq; // 已发布次数, 最低位为当前有效的缓冲区
+
+void TimerLib_UTC_Init(void)
+{
+    TimerLib_ClockMap_Init(&utc_map[0], TimerLib_GetClockFreq(), 1000000000);
+    utc_map[1] = utc_map[0];
+    __atomic_store_n(&utc_seq, 0, __ATOMIC_RELEASE);
+}
+
+void TimerLib_UTC_AddReference(uint64_t tick, uint64_t utc_ns)
+{
+    uint32_t seq = __atomic_load_n(&utc_seq, __ATOMIC_RELAXED);
+    TimerLib_ClockMap *next = &utc_map[(seq + 1) & 1];
+
+    *next = utc_map[seq & 1];
+    TimerLib_ClockMap_AddSample(next, tick, utc_ns);
+    __atomic_store_n(&utc_seq, seq + 1, __ATOMIC_RELEASE);
+}
+
+bool TimerLib_UTC_IsValid(void)
+{
+    return utc_map[__atomic_load_n(&utc_seq, __ATOMIC_ACQUIRE) & 1].count != 0;
+}
+
+uint64_t TimerLib_UTC_FromTick(uint64_t tick)
+{
+    uint32_t seq;
+    uint64_t utc;
+
+    do
+    {
+        seq = __atomic_load_n(&utc_seq, __ATOMIC_ACQUIRE);
+        utc = TimerLib_ClockMap_Convert(&utc_map[seq & 1], tick);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while (__atomic_load_n(&utc_seq, __ATOMIC_RELAXED) != seq);
+
+    return utc;
+}
+
+uint64_t TimerLib_UTC_Now_ns(void)
+{
+    return TimerLib_UTC_FromTick(TimerLib_GetTimestamp_tick());
+}
+
+uint32_t TimerLib_UTC_ErrorBound_ns(void)
+{
+    return TimerLib_ClockMap_ErrorBound(&utc_map[__atomic_load_n(&utc_seq, __ATOMIC_ACQUIRE) & 1]);
+}
@@ -0,0 +1,83 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* TimerLib_UTC.h */
+#pragma once
+#include "TimerLib_ClockMap.h"
+
+/*
+ * 时间戳到UTC的映射
+ *
+ * 从外部时间源(GPS秒脉冲、NTP、上位机等)取得(tick, UTC)参考对，由
+ * TimerLib_ClockMap 在样本窗口上平滑估计偏移和速率，之后任意tick时间戳
+ * 只需一次乘加即可换算为UTC纳秒:
+ *
+ *   TimerLib_UTC_Init();
+ *   // GPS秒脉冲中断中
+ *   TimerLib_UTC_AddReference(TimerLib_GetTimestamp_tick(), gps_utc_ns);
+ *   // 写日志时
+ *   uint64_t utc_ns = TimerLib_UTC_Now_ns();
+ */
+
+/**
+ * @brief 初始化UTC映射，按当前定时器时钟频率设置标称速率
+ * @note 调用 TimerLib_ClockChangeEnd 切换时钟后需要重新初始化
+ */
+void TimerLib_UTC_Init(void);
+
+/**
+ * @brief 加入一个参考对
+ * @param tick 参考时刻的时间戳(tick)
+ * @param utc_ns 参考时刻的UTC(自1970-01-01起的纳秒)
+ * @note 新的拟合结果整体发布，可在中断中调用，换算函数在任意上下文中都不会读到新旧混合的参数；
+ *       同一时刻只能有一个调用者
+ * @note 每次调用都在窗口上重新做双精度拟合，无双精度FPU的内核上为软件浮点，耗时远大于一次换算，
+ *       高优先级中断中可只记录参考对，经TimerLib_Defer推迟到线程中调用
+ */
+void TimerLib_UTC_AddReference(uint64_t tick, uint64_t utc_ns);
+
+/**
+ * @brief 是否已加入参考对
+ * @return true表示换算结果有效
+ */
+bool TimerLib_UTC_IsValid(void);
+
+/**
+ * @brief 将时间戳换算为UTC
+ * @param tick 时间戳(tick)
+ * @return UTC纳秒
+ */
+uint64_t TimerLib_UTC_FromTick(uint64_t tick);
+
+/**
+ * @brief 获取当前UTC
+ * @return UTC纳秒
+ */
+uint64_t TimerLib_UTC_Now_ns(void);
+
+/**
+ * @brief 获取换算误差界
+ * @return 参考窗口范围内的误差上界(纳秒)
+ */
+uint32_t TimerLib_UTC_ErrorBound_ns(void);
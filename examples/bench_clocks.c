@@ -0,0 +1,209 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_clocks.c
+ * @brief Linux主机上比较TimerLib与系统时钟源的读取耗时、分辨率与单调性,
+ *        以及多个线程同时读取时的单次耗时
+ *
+ * 构建与运行: make -C examples && ./examples/bench_clocks [最大线程数]
+ * std::chrono::steady_clock 在Linux上即CLOCK_MONOTONIC。
+ */
+#include "TimerLib_Bench.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#define CONTENTION_READS 200000 // 竞争测试中每个线程的读取次数
+#define MAX_THREADS 64
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_RDTSC 1
+#endif
+
+static uint64_t read_clock(clockid_t id)
+{
+    struct timespec ts;
+
+    clock_gettime(id, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t read_monotonic(void) { return read_clock(CLOCK_MONOTONIC); }
+static uint64_t read_monotonic_raw(void) { return read_clock(CLOCK_MONOTONIC_RAW); }
+static uint64_t read_monotonic_coarse(void) { return read_clock(CLOCK_MONOTONIC_COARSE); }
+static uint64_t read_realtime(void) { return read_clock(CLOCK_REALTIME); }
+static uint64_t read_boottime(void) { return read_clock(CLOCK_BOOTTIME); }
+static uint64_t read_process_cputime(void) { return read_clock(CLOCK_PROCESS_CPUTIME_ID); }
+
+#ifdef HAVE_RDTSC
+static uint64_t read_rdtsc(void) { return __rdtsc(); }
+
+static uint64_t read_rdtscp(void)
+{
+    unsigned int aux;
+
+    return __rdtscp(&aux);
+}
+
+/**
+ * @brief 以CLOCK_MONOTONIC_RAW为基准标定TSC频率
+ */
+static uint64_t calibrate_tsc(void)
+{
+    uint64_t t0 = read_monotonic_raw();
+    uint64_t c0 = __rdtsc();
+    uint64_t t1, c1;
+
+    do
+    {
+        t1 = read_monotonic_raw();
+    } while (t1 - t0 < 100000000);
+    c1 = __rdtsc();
+
+    return (c1 - c0) * 1000000000 / (t1 - t0);
+}
+#endif
+
+/**
+ * @brief 竞争测试中的一个线程
+ */
+typedef struct
+{
+    const TimerLib_BenchClock *clk;
+    pthread_barrier_t *start;
+    uint64_t ns;        // 完成全部读取的耗时
+    uint32_t backwards; // 本线程内读值回退次数
+} Worker;
+
+static void *contend(void *arg)
+{
+    Worker *w = arg;
+    uint64_t t0, prev, now;
+
+    pthread_barrier_wait(w->start);
+    t0 = read_monotonic_raw();
+    prev = w->clk->read();
+    for (uint32_t i = 0; i < CONTENTION_READS; i++)
+    {
+        now = w->clk->read();
+        w->backwards += (now < prev);
+        prev = now;
+    }
+    w->ns = read_monotonic_raw() - t0;
+    return NULL;
+}
+
+/**
+ * @brief 多个线程同时读取同一时钟, 返回平均单次耗时(皮秒)
+ */
+static uint64_t run_contention(const TimerLib_BenchClock *clk, uint32_t threads, uint32_t *backwards)
+{
+    pthread_t tid[MAX_THREADS];
+    Worker workers[MAX_THREADS];
+    pthread_barrier_t start;
+    uint64_t total_ns = 0;
+
+    pthread_barrier_init(&start, NULL, threads);
+    for (uint32_t i = 0; i < threads; i++)
+    {
+        workers[i] = (Worker){clk, &start, 0, 0};
+        pthread_create(&tid[i], NULL, contend, &workers[i]);
+    }
+    *backwards = 0;
+    for (uint32_t i = 0; i < threads; i++)
+    {
+        pthread_join(tid[i], NULL);
+        total_ns += workers[i].ns;
+        *backwards += workers[i].backwards;
+    }
+    pthread_barrier_destroy(&start);
+
+    return total_ns * 1000 / ((uint64_t)threads * (CONTENTION_READS + 1));
+}
+
+int main(int argc, char **argv)
+{
+    TimerLib_BenchClock clocks[] = {
+        {"TimerLib", TimerLib_GetTimestamp_tick, 1000000000},
+        {"CLOCK_MONOTONIC", read_monotonic, 1000000000},
+        {"CLOCK_MONOTONIC_RAW", read_monotonic_raw, 1000000000},
+        {"CLOCK_MONOTONIC_COARSE", read_monotonic_coarse, 1000000000},
+        {"CLOCK_REALTIME", read_realtime, 1000000000},
+        {"CLOCK_BOOTTIME", read_boottime, 1000000000},
+        {"CLOCK_PROCESS_CPUTIME_ID", read_process_cputime, 1000000000},
+#ifdef HAVE_RDTSC
+        {"RDTSC", read_rdtsc, 0},
+        {"RDTSCP", read_rdtscp, 0},
+#endif
+    };
+    uint32_t count = sizeof(clocks) / sizeof(clocks[0]);
+    long max_threads = (argc > 1) ? atol(argv[1]) : sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (max_threads < 1)
+    {
+        max_threads = 1;
+    }
+    if (max_threads > MAX_THREADS)
+    {
+        max_threads = MAX_THREADS;
+    }
+
+    TimerLib_GlobalInit(0xFFFFFFFF, 1000000000);
+#ifdef HAVE_RDTSC
+    clocks[count - 2].freq = calibrate_tsc();
+    clocks[count - 1].freq = clocks[count - 2].freq;
+#endif
+
+    printf("%-26s %12s %14s %10s %10s\n", "clock", "call_ps", "resolution_ps", "backwards", "repeats");
+    for (uint32_t i = 0; i < count; i++)
+    {
+        TimerLib_BenchClockResult res;
+
+        if (TimerLib_Bench_Clock(&clocks[i], 100000, &res) != 0)
+        {
+            printf("%-26s failed\n", clocks[i].name);
+            continue;
+        }
+        printf("%-26s %12llu %14llu %10u %10u\n", clocks[i].name, (unsigned long long)res.call_ps,
+               (unsigned long long)res.resolution_ps, res.backwards, res.repeats);
+    }
+
+    // TimerLib的临界区在linux/tim.h中为互斥锁, 多线程时读取被串行化
+    printf("\n%-26s %8s %12s %10s\n", "clock", "threads", "call_ps", "backwards");
+    for (uint32_t i = 0; i < count; i++)
+    {
+        for (uint32_t threads = 1; threads <= (uint32_t)max_threads; threads *= 2)
+        {
+            uint32_t backwards;
+            uint64_t call_ps = run_contention(&clocks[i], threads, &backwards);
+
+            printf("%-26s %8u %12llu %10u\n", clocks[i].name, threads, (unsigned long long)call_ps, backwards);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file bench_delay.c
+ * @brief Linux主机上测量各延时函数的超调(实际耗时减请求时长)分布
+ *
+ * 构建与运行: make -C examples && ./examples/bench_delay
+ * 实际耗时以CLOCK_MONOTONIC_RAW测量, 与TimerLib替身的计数来源相同。
+ */
+#include "TimerLib.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define RUNS 2001
+
+static uint64_t read_raw(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static void measure(const char *name, void (*delay)(uint32_t), uint32_t amount, uint64_t request_ns)
+{
+    static uint64_t over[RUNS];
+    uint32_t shorter = 0;
+
+    for (uint32_t i = 0; i < RUNS; i++)
+    {
+        uint64_t t0 = read_raw();
+        uint64_t elapsed;
+
+        delay(amount);
+        elapsed = read_raw() - t0;
+        shorter += (elapsed < request_ns);
+        over[i] = (elapsed > request_ns) ? elapsed - request_ns : 0;
+    }
+    qsort(over, RUNS, sizeof(over[0]), cmp_u64);
+
+    printf("%-24s %10llu %8llu %8llu %8llu %8u\n", name, (unsigned long long)request_ns,
+           (unsigned long long)over[RUNS / 2], (unsigned long long)over[RUNS * 9 / 10],
+           (unsigned long long)over[RUNS * 99 / 100], shorter);
+}
+
+int main(void)
+{
+    TimerLib_GlobalInit(0xFFFFFFFF, 1000000000);
+
+    printf("%-24s %10s %8s %8s %8s %8s\n", "delay", "request_ns", "p50_ns", "p90_ns", "p99_ns", "short");
+    measure("DelayNS(1000)", TimerLib_DelayNS, 1000, 1000);
+    measure("DelayNS(20000)", TimerLib_DelayNS, 20000, 20000);
+    measure("DelayUS(10)", TimerLib_DelayUS, 10, 10000);
+    measure("DelayUS(1000)", TimerLib_DelayUS, 1000, 1000000);
+    measure("DelayUS_32(10)", TimerLib_DelayUS_32, 10, 10000);
+    return 0;
+}
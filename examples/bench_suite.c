@@ -0,0 +1,127 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file bench_suite.c
+ * @brief Linux主机上运行TimerLib基准测试套件, 与基线JSON比较, 有回归时返回非0
+ *
+ * 构建与运行: make -C examples bench-check
+ * 更新基线:   make -C examples bench-baseline
+ */
+#include "TimerLib_Bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_TOLERANCE_PCT 50 // 调用耗时指标的默认容差
+
+// 主机上的延时超调受调度影响, 以纳秒计的基线很小, 放宽容差
+static const TimerLib_BenchTolerance tolerances[] = {
+    {"DelayNS_1000_overshoot_ns", 400},
+    {"DelayUS_10_overshoot_ns", 400},
+    {"DelayUS_1000_overshoot_ns", 400},
+    {"DelayUS_32Short_10_overshoot_ns", 400},
+    {"DelayUS_32_10_overshoot_ns", 400},
+    {"Delay_ns_1000_overshoot_ns", 400},
+    {"Delay_ns_100000_overshoot_ns", 400},
+};
+
+static void print_line(const char *line, void *ctx)
+{
+    (void)ctx;
+    puts(line);
+}
+
+static char *read_file(const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    char *buf;
+    long size;
+
+    if (f == 0)
+    {
+        return 0;
+    }
+    fseek(f, 0, SEEK_END);
+    size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    buf = malloc((size_t)size + 1);
+    if (buf != 0)
+    {
+        buf[fread(buf, 1, (size_t)size, f)] = '\0';
+    }
+    fclose(f);
+    return buf;
+}
+
+int main(int argc, char **argv)
+{
+    TimerLib_BenchMetric metrics[TIMERLIB_BENCH_SUITE_SIZE];
+    char json[2048];
+    char *baseline;
+    uint32_t count;
+    int regressions;
+
+    if (argc < 2 || (strcmp(argv[1], "--update") == 0 && argc < 3))
+    {
+        fprintf(stderr, "usage: %s [--update] baseline.json\n", argv[0]);
+        return 2;
+    }
+
+    TimerLib_GlobalInit(0xFFFFFFFF, 1000000000);
+    count = TimerLib_Bench_RunSuite(metrics, TIMERLIB_BENCH_SUITE_SIZE);
+    if (count == 0 || TimerLib_Bench_WriteJSON(metrics, count, json, sizeof(json)) < 0)
+    {
+        fprintf(stderr, "benchmark suite failed\n");
+        return 2;
+    }
+
+    if (strcmp(argv[1], "--update") == 0)
+    {
+        FILE *f = fopen(argv[2], "w");
+
+        if (f == 0)
+        {
+            perror(argv[2]);
+            return 2;
+        }
+        fprintf(f, "%s\n", json);
+        fclose(f);
+        printf("%s\n", json);
+        return 0;
+    }
+
+    baseline = read_file(argv[1]);
+    if (baseline == 0)
+    {
+        perror(argv[1]);
+        return 2;
+    }
+    regressions = TimerLib_Bench_Compare(metrics, count, baseline, tolerances,
+                                         sizeof(tolerances) / sizeof(tolerances[0]), DEFAULT_TOLERANCE_PCT,
+                                         print_line, 0);
+    free(baseline);
+
+    printf("%d regression(s)\n", regressions);
+    return regressions != 0;
+}
@@ -0,0 +1,73 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* tim.h */
+#pragma once
+#include <pthread.h>
+#include <stdint.h>
+#include <time.h>
+
+/*
+ * Linux主机上的定时器替身, 代替目标板上的CubeMX生成的tim.h
+ *
+ * 以CLOCK_MONOTONIC_RAW纳秒数的低32位作为计数值(1GHz, ARR=0xFFFFFFFF)。
+ * 主机上没有更新中断, 需以TIMERLIB_SOFT_OVERFLOW编译, 由软件跟踪回绕;
+ * 基准测试持续读取计数器, 满足每个溢出周期(约4.3秒)至少读取一次的要求。
+ * 临界区以互斥锁代替关中断, 多个线程可以同时读取时间戳; 嵌套深度按线程记录,
+ * 与PRIMASK的保存/恢复语义相同。
+ */
+
+static inline uint32_t linux_tim_read(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec);
+}
+
+static pthread_mutex_t linux_tim_lock = PTHREAD_MUTEX_INITIALIZER;
+static _Thread_local uint32_t linux_tim_depth;
+
+#define TIM1 0
+#define LL_TIM_GetCounter(tim) ((void)(tim), linux_tim_read())
+#define LL_TIM_SetCounter(tim, cnt) ((void)(tim), (void)(cnt))
+
+#define TIMERLIB_CRITICAL_ENTER(state)              \
+    do                                              \
+    {                                               \
+        (state) = linux_tim_depth++;                \
+        if ((state) == 0)                           \
+        {                                           \
+            pthread_mutex_lock(&linux_tim_lock);    \
+        }                                           \
+    } while (0)
+#define TIMERLIB_CRITICAL_EXIT(state)               \
+    do                                              \
+    {                                               \
+        linux_tim_depth = (state);                  \
+        if ((state) == 0)                           \
+        {                                           \
+            pthread_mutex_unlock(&linux_tim_lock);  \
+        }                                           \
+    } while (0)
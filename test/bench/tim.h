@@ -0,0 +1,41 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/* tim.h */
+#pragma once
+#include <stdint.h>
+
+/*
+ * 主机微基准用的定时器替身: 计数值为一个volatile变量(相当于一次外设寄存器读取),
+ * 没有更新中断, 只用于测量时间戳合成与间隔计算本身的开销, 不用于正确性测试。
+ */
+
+extern volatile uint32_t bench_tim_cnt;
+extern uint32_t bench_primask;
+
+#define TIM1 0
+#define LL_TIM_GetCounter(tim) ((void)(tim), bench_tim_cnt)
+#define LL_TIM_SetCounter(tim, cnt) ((void)(tim), bench_tim_cnt = (cnt))
+#define __get_PRIMASK() (bench_primask)
+#define __set_PRIMASK(mask) (bench_primask = (mask))
+#define __disable_irq() (bench_primask = 1)
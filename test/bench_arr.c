@@ -0,0 +1,117 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file bench_arr.c
+ * @brief 主机微基准: 溢出周期为2的幂时的移位路径与通用乘法路径的单次调用开销
+ *
+ * 同一源文件按三种方式编译(make -C test bench):
+ *   bench_arr_mul     ARR=64999, 运行时选择乘法路径
+ *   bench_arr_pow2    ARR=65535, 运行时选择移位路径
+ *   bench_arr_bits16  ARR=65535, -DTIMERLIB_ARR_BITS=16, 编译期固定移位路径
+ */
+#include "TimerLib.h"
+#include "tim.h"
+#include <stdio.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_RDTSC 1
+#endif
+
+#ifndef BENCH_ARR
+#define BENCH_ARR 65535
+#endif
+
+#define CALLS 10000000
+
+volatile uint32_t bench_tim_cnt = 12345;
+uint32_t bench_primask;
+
+static volatile uint64_t sink;
+static TimerLib_Handle handle;
+static TimerLib_Handle16 handle16;
+
+static void call_timestamp(void) { sink = TimerLib_GetTimestamp_tick(); }
+static void call_interval_q32(void) { sink = TimerLib_GetInterval_q32(&handle); }
+static void call_interval16(void) { sink = TimerLib_GetInterval16_ticks(&handle16); }
+static void call_none(void) { sink = bench_tim_cnt; }
+
+static uint64_t host_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief 测量单次调用耗时, 取11轮中的最小值
+ */
+static void measure(const char *name, void (*fn)(void))
+{
+    uint64_t best_ns = UINT64_MAX, best_cycles = UINT64_MAX;
+
+    for (int round = 0; round < 11; round++)
+    {
+        uint64_t t0 = host_ns();
+#ifdef HAVE_RDTSC
+        uint64_t c0 = __rdtsc();
+#endif
+        for (uint32_t i = 0; i < CALLS; i++)
+        {
+            fn();
+        }
+#ifdef HAVE_RDTSC
+        uint64_t cycles = __rdtsc() - c0;
+        best_cycles = (cycles < best_cycles) ? cycles : best_cycles;
+#endif
+        uint64_t ns = host_ns() - t0;
+        best_ns = (ns < best_ns) ? ns : best_ns;
+    }
+
+    printf("  %-22s %7.2f ns", name, (double)best_ns / CALLS);
+#ifdef HAVE_RDTSC
+    printf(" %7.2f TSC cycles", (double)best_cycles / CALLS);
+#endif
+    printf("\n");
+}
+
+int main(void)
+{
+    TimerLib_GlobalInit(BENCH_ARR, 72000000);
+    TimerLib_InitHandle(&handle);
+    TimerLib_InitHandle16(&handle16);
+
+#ifdef TIMERLIB_ARR_BITS
+    printf("ARR=%u, TIMERLIB_ARR_BITS=%d (shift path fixed at compile time)\n", BENCH_ARR, TIMERLIB_ARR_BITS);
+#else
+    printf("ARR=%u (%s path selected at init)\n", BENCH_ARR, ((BENCH_ARR + 1) & BENCH_ARR) ? "multiply" : "shift");
+#endif
+    measure("counter read only", call_none);
+    measure("GetTimestamp_tick", call_timestamp);
+    measure("GetInterval_q32", call_interval_q32);
+    measure("GetInterval16_ticks", call_interval16);
+    return 0;
+}
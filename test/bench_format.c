@@ -0,0 +1,170 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file bench_format.c
+ * @brief 主机微基准: TimerLib_Format 与等价的 snprintf 实现的单次调用耗时
+ *
+ * 构建与运行: make -C test bench
+ * 两种实现对同一组tick值输出必须一致, 不一致时以非0退出。
+ * 各量级分别测量, 最后一组超过2^32秒, 走分钟/小时的分段长除路径。
+ */
+#include "TimerLib_Format.h"
+#include "tim.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define FREQ 72000000u
+#define VALUES 64
+#define CALLS 100000
+
+volatile uint32_t bench_tim_cnt;
+uint32_t bench_primask;
+
+static volatile uint32_t sink;
+static uint64_t values[VALUES];
+
+static uint32_t ref_duration(char *out, uint32_t size, uint64_t ticks)
+{
+    uint64_t s = ticks / FREQ;
+    uint64_t ns = ticks % FREQ * 1000000000 / FREQ;
+
+    if (s == 0 && ns < 1000)
+    {
+        return (uint32_t)snprintf(out, size, "%" PRIu64 "ns", ns);
+    }
+    if (s == 0 && ns < 1000000)
+    {
+        return (uint32_t)snprintf(out, size, "%" PRIu64 ".%03" PRIu64 "us", ns / 1000, ns % 1000);
+    }
+    if (s == 0)
+    {
+        return (uint32_t)snprintf(out, size, "%" PRIu64 ".%03" PRIu64 "ms", ns / 1000000, ns / 1000 % 1000);
+    }
+    if (s < 60)
+    {
+        return (uint32_t)snprintf(out, size, "%" PRIu64 ".%03" PRIu64 "s", s, ns / 1000000);
+    }
+    if (s < 3600)
+    {
+        return (uint32_t)snprintf(out, size, "%" PRIu64 "m%02" PRIu64 "s", s / 60, s % 60);
+    }
+    return (uint32_t)snprintf(out, size, "%" PRIu64 "h%02" PRIu64 "m%02" PRIu64 "s", s / 3600, s / 60 % 60, s % 60);
+}
+
+static uint32_t ref_seconds(char *out, uint32_t size, uint64_t ticks)
+{
+    uint64_t ns = ticks % FREQ * 1000000000 / FREQ;
+
+    return (uint32_t)snprintf(out, size, "%" PRIu64 ".%06" PRIu64, ticks / FREQ, ns / 1000);
+}
+
+static uint32_t lib_duration(char *out, uint32_t size, uint64_t ticks)
+{
+    return TimerLib_Format_Duration(out, size, ticks);
+}
+
+static uint32_t lib_seconds(char *out, uint32_t size, uint64_t ticks)
+{
+    return TimerLib_Format_Seconds(out, size, ticks, 6);
+}
+
+static uint64_t host_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief 测量单次调用耗时(ns), 取11轮中的最小值
+ */
+static double measure(uint32_t (*fn)(char *, uint32_t, uint64_t))
+{
+    char buf[TIMERLIB_FORMAT_MAX];
+    uint64_t best = UINT64_MAX;
+
+    for (int round = 0; round < 11; round++)
+    {
+        uint64_t t0 = host_ns();
+
+        for (uint32_t i = 0; i < CALLS; i++)
+        {
+            sink += fn(buf, sizeof(buf), values[i % VALUES]);
+        }
+        uint64_t ns = host_ns() - t0;
+        best = (ns < best) ? ns : best;
+    }
+    return (double)best / CALLS;
+}
+
+/**
+ * @brief 以[lo, hi)内等距的VALUES个tick值比较两种实现
+ */
+static int run(const char *name, uint64_t lo, uint64_t hi)
+{
+    char a[TIMERLIB_FORMAT_MAX], b[TIMERLIB_FORMAT_MAX];
+
+    for (uint32_t i = 0; i < VALUES; i++)
+    {
+        values[i] = lo + (hi - lo) / VALUES * i + i;
+        lib_duration(a, sizeof(a), values[i]);
+        ref_duration(b, sizeof(b), values[i]);
+        if (strcmp(a, b) != 0)
+        {
+            printf("Duration mismatch at %" PRIu64 ": %s vs %s\n", values[i], a, b);
+            return 1;
+        }
+        lib_seconds(a, sizeof(a), values[i]);
+        ref_seconds(b, sizeof(b), values[i]);
+        if (strcmp(a, b) != 0)
+        {
+            printf("Seconds mismatch at %" PRIu64 ": %s vs %s\n", values[i], a, b);
+            return 1;
+        }
+    }
+
+    printf("  %-10s Duration %7.1f ns (snprintf %7.1f)   Seconds %7.1f ns (snprintf %7.1f)\n", name,
+           measure(lib_duration), measure(ref_duration), measure(lib_seconds), measure(ref_seconds));
+    return 0;
+}
+
+int main(void)
+{
+    int err = 0;
+
+    TimerLib_GlobalInit(0xFFFFFFFF, FREQ);
+
+    printf("TimerLib_Format vs snprintf, %u Hz\n", FREQ);
+    err |= run("ns", 0, FREQ / 1000000);
+    err |= run("us", FREQ / 1000000, FREQ / 1000);
+    err |= run("ms", FREQ / 1000, FREQ);
+    err |= run("s", FREQ, 60ull * FREQ);
+    err |= run("m", 60ull * FREQ, 3600ull * FREQ);
+    err |= run("h", 3600ull * FREQ, 1000000ull * FREQ);
+    err |= run(">2^32 s", ((uint64_t)1 << 32) * FREQ, UINT64_MAX - VALUES);
+    return err;
+}
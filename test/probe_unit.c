@@ -0,0 +1,53 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file probe_unit.c
+ * @brief 探针代码体积对照: 定义PROBE_UNIT_PROBED时插入探针, 否则为同一函数的无探针版本
+ *
+ * 两者都以TIMERLIB_PROBE_OFF编译, 由test/Makefile比较目标文件的段大小与.text内容。
+ */
+#include "TimerLib_Probe.h"
+
+#ifdef PROBE_UNIT_PROBED
+TIMERLIB_PROBE_DEFINE(filter);
+TIMERLIB_PROBE_DEFINE(sample);
+#else
+#define TIMERLIB_PROBE_BEGIN(name) ((void)0)
+#define TIMERLIB_PROBE_END(name) ((void)0)
+#define TIMERLIB_PROBE_EVENT(name) ((void)0)
+#endif
+
+static int32_t state;
+
+int32_t probe_unit_filter(const int16_t *samples, uint32_t n)
+{
+    TIMERLIB_PROBE_BEGIN(filter);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        TIMERLIB_PROBE_EVENT(sample);
+        state += (samples[i] - state) >> 3;
+    }
+    TIMERLIB_PROBE_END(filter);
+    return state;
+}
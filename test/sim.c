@@ -0,0 +1,164 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file sim.c
+ * @brief 主机测试用的定时器模拟
+ */
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 199309L
+#endif
+#include "tim.h"
+#include "TimerLib.h"
+#include <time.h>
+
+SimTimer sim;
+int sim_failures;
+
+static void deliver(void)
+{
+    while (sim.pending != 0 && sim.primask == 0)
+    {
+        sim.pending--;
+        sim.irqs++;
+        TimerLib_HandleUpdateIRQ();
+        if (sim.on_irq != 0)
+        {
+            // 中断服务期间同一中断不会嵌套
+            sim.primask = 1;
+            sim.on_irq();
+            sim.primask = 0;
+        }
+    }
+}
+
+void sim_reset(uint64_t period, uint32_t step)
+{
+    sim = (SimTimer){0};
+    sim.period = period;
+    sim.step = step;
+    sim.rep = 1;
+    sim.irq_enabled = true;
+    sim.running = true;
+}
+
+void sim_advance(uint64_t ticks)
+{
+    sim.real += ticks;
+    if (!sim.running)
+    {
+        return;
+    }
+
+    // 逐个处理跨越的回绕, 硬件重复计数器每rep次回绕产生一次更新事件
+    while (ticks > 0)
+    {
+        uint64_t to_wrap = sim.period - sim.ticks % sim.period;
+
+        if (ticks < to_wrap)
+        {
+            sim.ticks += ticks;
+            break;
+        }
+        sim.ticks += to_wrap;
+        ticks -= to_wrap;
+        if (++sim.rep_phase == sim.rep)
+        {
+            sim.rep_phase = 0;
+            if (sim.irq_enabled)
+            {
+                sim.pending++;
+            }
+        }
+        deliver();
+    }
+    deliver();
+}
+
+uint64_t sim_now(void)
+{
+    return sim.ticks;
+}
+
+static uint64_t host_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+}
+
+void sim_use_host_clock(uint32_t hz)
+{
+    sim.host_hz = hz;
+    sim.host_last = host_ns();
+    sim.host_rem = 0;
+}
+
+uint32_t sim_read(void)
+{
+    uint32_t value;
+
+    sim.reads++;
+    if (sim.host_hz != 0)
+    {
+        uint64_t now = host_ns();
+        uint64_t acc = (now - sim.host_last) * sim.host_hz + sim.host_rem;
+
+        sim.host_last = now;
+        sim.host_rem = acc % 1000000000;
+        sim_advance(acc / 1000000000);
+    }
+    else if (sim.slow_div != 0)
+    {
+        if (sim.reads % sim.slow_div == 0)
+        {
+            sim_advance(1);
+        }
+    }
+    else
+    {
+        sim_advance(sim.step);
+    }
+
+    value = (uint32_t)(sim.ticks % sim.period);
+    if (sim.torn_every != 0 && sim.reads % sim.torn_every == 0)
+    {
+        // 跨时钟域读取时部分位取自上一个计数值
+        value ^= 0x1F0;
+        sim.torn++;
+    }
+    return value;
+}
+
+void sim_set_counter(uint32_t cnt)
+{
+    sim.ticks = sim.ticks - sim.ticks % sim.period + cnt;
+}
+
+void sim_set_primask(uint32_t mask)
+{
+    sim.primask = mask;
+    deliver();
+}
@@ -0,0 +1,58 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_async_read.c
+ * @brief 异步时钟定时器读取测试(TIMERLIB_ASYNC_READ): 注入撕裂读数, 时间戳必须正确
+ */
+#include "TimerLib.h"
+#include "tim.h"
+
+int main(void)
+{
+    const int n = 200000;
+    uint64_t prev = 0;
+    uint64_t reads;
+    int i;
+
+    sim_reset(1000, 1);
+    sim.slow_div = 4;   // 计数时钟慢于内核, 每4次读取前进1个tick
+    sim.torn_every = 7; // 每7次读取有一次撕裂
+    TimerLib_GlobalInit(999, 1000000);
+
+    reads = sim.reads;
+    for (i = 0; i < n; i++)
+    {
+        uint64_t ts = TimerLib_GetTimestamp_tick();
+
+        SIM_CHECK(ts >= prev);
+        SIM_CHECK(ts <= sim_now() && sim_now() - ts <= 1);
+        prev = ts;
+    }
+    SIM_CHECK(sim.torn > 0);
+
+    printf("%s: %s (%.2f reads per timestamp, %llu torn reads injected)\n", __FILE__,
+           sim_failures ? "FAILED" : "ok", (double)(sim.reads - reads) / n, (unsigned long long)sim.torn);
+    return sim_failures != 0;
+}
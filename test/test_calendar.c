@@ -0,0 +1,184 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file test_calendar.c
+ * @brief 日历时钟测试: 日期与Unix时间互相换算一致, 逐秒进位的字符串与重新格式化的结果相同,
+ *        跨越年、闰日和世纪边界以及长时间未读取时日期正确, 无效日期与超范围的Unix时间被拒绝
+ */
+#include "TimerLib_Calendar.h"
+#include "tim.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define FREQ 1000 // 1kHz定时器, 一秒1000个tick
+
+static uint64_t rand_unix(void)
+{
+    uint64_t v = (uint64_t)rand() << 31 ^ (uint64_t)rand();
+
+    return v % (TIMERLIB_CALENDAR_UNIX_MAX + 1);
+}
+
+/**
+ * @brief 已知日期与Unix时间的对应
+ */
+static void known(void)
+{
+    static const struct
+    {
+        uint16_t year;
+        uint8_t month, day, hour, minute, second;
+        uint64_t unix_seconds;
+        const char *text;
+    } dates[] = {
+        {1970, 1, 1, 0, 0, 0, 0, "1970-01-01 00:00:00"},
+        {2000, 2, 29, 12, 0, 0, 951825600, "2000-02-29 12:00:00"},
+        {2025, 10, 9, 8, 53, 20, 1760000000, "2025-10-09 08:53:20"},
+        {2038, 1, 19, 3, 14, 8, 2147483648ull, "2038-01-19 03:14:08"},
+        {2100, 3, 1, 0, 0, 0, 4107542400ull, "2100-03-01 00:00:00"},
+        {9999, 12, 31, 23, 59, 59, TIMERLIB_CALENDAR_UNIX_MAX, "9999-12-31 23:59:59"},
+    };
+    TimerLib_Calendar cal;
+
+    for (uint32_t i = 0; i < sizeof(dates) / sizeof(dates[0]); i++)
+    {
+        SIM_CHECK(TimerLib_Calendar_Init(&cal, dates[i].year, dates[i].month, dates[i].day, dates[i].hour,
+                                         dates[i].minute, dates[i].second) == 0);
+        SIM_CHECK(cal.unix_seconds == dates[i].unix_seconds);
+        SIM_CHECK(strcmp(cal.text, dates[i].text) == 0);
+
+        SIM_CHECK(TimerLib_Calendar_InitUnix(&cal, dates[i].unix_seconds) == 0);
+        SIM_CHECK(strcmp(cal.text, dates[i].text) == 0);
+    }
+}
+
+/**
+ * @brief 随机Unix时间换算成日期后再换算回来必须相同
+ */
+static void round_trip(void)
+{
+    TimerLib_Calendar a, b;
+
+    for (int i = 0; i < 200000; i++)
+    {
+        uint64_t t = (i < 100) ? TIMERLIB_CALENDAR_UNIX_MAX - (uint64_t)i : rand_unix();
+
+        SIM_CHECK(TimerLib_Calendar_InitUnix(&a, t) == 0);
+        SIM_CHECK(TimerLib_Calendar_Init(&b, a.year, a.month, a.day, a.hour, a.minute, a.second) == 0);
+        SIM_CHECK(b.unix_seconds == t);
+        SIM_CHECK(strcmp(a.text, b.text) == 0);
+    }
+}
+
+/**
+ * @brief 从start开始逐秒推进seconds秒, 每秒的字符串与直接由Unix时间格式化的结果相同
+ */
+static void walk(uint64_t start, uint32_t seconds)
+{
+    TimerLib_Calendar cal, ref;
+
+    SIM_CHECK(TimerLib_Calendar_InitUnix(&cal, start) == 0);
+    for (uint32_t s = 1; s <= seconds; s++)
+    {
+        sim_advance(FREQ);
+        TimerLib_Calendar_Get(&cal);
+        SIM_CHECK(cal.unix_seconds == start + s);
+        (void)TimerLib_Calendar_InitUnix(&ref, start + s);
+        SIM_CHECK(strcmp(cal.text, ref.text) == 0);
+    }
+}
+
+static void carries(void)
+{
+    TimerLib_Calendar cal;
+
+    walk(946684790, 20);       // 1999-12-31 23:59:50 跨年、跨世纪
+    walk(951782390, 20);       // 2000-02-28 23:59:50 世纪闰年有2月29日
+    walk(1709164790, 20);      // 2024-02-28 23:59:50 闰年
+    walk(1677628790, 20);      // 2023-02-28 23:59:50 平年直接进入3月
+    walk(4107542400 - 10, 20); // 2100-02-28 23:59:50 非闰的世纪年
+    walk(1760000000, 200000);  // 连续两天多, 覆盖所有时分秒进位
+
+    // 超过一分钟未读取: 一次性换算, 之后仍逐秒进位
+    SIM_CHECK(TimerLib_Calendar_InitUnix(&cal, 1709164799) == 0);
+    sim_advance((uint64_t)FREQ * (86400 + 5));
+    TimerLib_Calendar_Get(&cal);
+    SIM_CHECK(strcmp(cal.text, "2024-03-01 00:00:04") == 0);
+    sim_advance(FREQ);
+    TimerLib_Calendar_Get(&cal);
+    SIM_CHECK(strcmp(cal.text, "2024-03-01 00:00:05") == 0);
+
+    // 不足一秒时不变
+    sim_advance(FREQ - 1);
+    TimerLib_Calendar_Get(&cal);
+    SIM_CHECK(strcmp(cal.text, "2024-03-01 00:00:05") == 0);
+}
+
+static void invalid(void)
+{
+    static const struct
+    {
+        uint16_t year;
+        uint8_t month, day, hour, minute, second;
+    } dates[] = {
+        {1969, 12, 31, 23, 59, 59},
+        {10000, 1, 1, 0, 0, 0},
+        {2024, 0, 1, 0, 0, 0},
+        {2024, 13, 1, 0, 0, 0},
+        {2024, 1, 0, 0, 0, 0},
+        {2024, 4, 31, 0, 0, 0},
+        {2023, 2, 29, 0, 0, 0},
+        {2100, 2, 29, 0, 0, 0},
+        {2024, 1, 1, 24, 0, 0},
+        {2024, 1, 1, 0, 60, 0},
+        {2024, 1, 1, 0, 0, 60},
+    };
+    TimerLib_Calendar cal, saved;
+
+    SIM_CHECK(TimerLib_Calendar_InitUnix(&cal, 1760000000) == 0);
+    saved = cal;
+    for (uint32_t i = 0; i < sizeof(dates) / sizeof(dates[0]); i++)
+    {
+        SIM_CHECK(TimerLib_Calendar_Init(&cal, dates[i].year, dates[i].month, dates[i].day, dates[i].hour,
+                                         dates[i].minute, dates[i].second) == -1);
+    }
+    SIM_CHECK(TimerLib_Calendar_InitUnix(&cal, TIMERLIB_CALENDAR_UNIX_MAX + 1) == -1);
+    SIM_CHECK(TimerLib_Calendar_InitUnix(&cal, UINT64_MAX) == -1);
+    SIM_CHECK(memcmp(&cal, &saved, sizeof(cal)) == 0);
+}
+
+int main(void)
+{
+    srand(1);
+    sim_reset(65536, 0);
+    TimerLib_GlobalInit(65535, FREQ);
+
+    known();
+    round_trip();
+    carries();
+    invalid();
+
+    printf("%s: %s\n", __FILE__, sim_failures ? "FAILED" : "ok");
+    return sim_failures != 0;
+}
@@ -0,0 +1,156 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_clock_change.c
+ * @brief 运行时切换时钟测试: 切换后时间戳随计数器连续推进, 经过多次更新中断不得跳变
+ *
+ * 以默认、TIMERLIB_SOFT_OVERFLOW、TIMERLIB_REPETITION分别编译运行。
+ */
+#include "TimerLib.h"
+#include "tim.h"
+#include <stdlib.h>
+
+static void run(uint32_t arr, uint32_t rep, uint32_t seed)
+{
+    uint64_t period = (uint64_t)arr + 1;
+    uint64_t ts0, now0, prev;
+    int i, pre;
+
+    srand(seed);
+    sim_reset(period, 1 + (uint32_t)(period / 100));
+#if defined(TIMERLIB_SOFT_OVERFLOW)
+    (void)rep;
+    sim.irq_enabled = false;
+#elif defined(TIMERLIB_REPETITION)
+    sim.rep = rep;
+#else
+    (void)rep;
+#endif
+    TimerLib_GlobalInit(arr, 72000000);
+#ifdef TIMERLIB_REPETITION
+    TimerLib_SetRepetition(rep - 1);
+#endif
+
+    // 随机推进, 使切换发生在重复计数器的任意相位
+    pre = rand() % 10000;
+    for (i = 0; i < pre; i++)
+    {
+        sim_advance((uint64_t)rand() % (period - sim.step));
+        (void)TimerLib_GetTimestamp_tick();
+    }
+
+    // 定时器停止期间切换到半频(预分频加倍), ARR不变
+    TimerLib_ClockChangeBegin();
+    sim.running = false;
+    sim_advance(5 * period);
+    TimerLib_ClockChangeEnd(arr, 36000000);
+    sim.running = true;
+
+    ts0 = TimerLib_GetTimestamp_tick();
+    now0 = sim_now();
+    prev = ts0;
+    for (i = 0; i < 20000; i++)
+    {
+        uint64_t ts;
+
+        sim_advance((uint64_t)rand() % (period - sim.step));
+        ts = TimerLib_GetTimestamp_tick();
+        SIM_CHECK(ts - ts0 == sim_now() - now0);
+        SIM_CHECK(ts >= prev);
+        prev = ts;
+    }
+}
+
+// 模拟WFI: 睡眠直到半个溢出周期后的某个中断
+static void on_idle(void)
+{
+    sim_advance(sim.period / 2);
+}
+
+/**
+ * @brief 时钟切换后走休眠策略的延时: 目标须落在新的时间线上,
+ *        且早于纪元起点的绝对目标应立即返回
+ */
+static void sleep_after_switch(uint32_t arr, uint32_t from, uint32_t to)
+{
+    uint64_t period = (uint64_t)arr + 1;
+    uint64_t before, now0, need, elapsed;
+    int i;
+
+    sim_reset(period, 1 + (uint32_t)(period / 100));
+#ifdef TIMERLIB_SOFT_OVERFLOW
+    sim.irq_enabled = false;
+#endif
+    TimerLib_GlobalInit(arr, from);
+    TimerLib_SetIdleHook(on_idle);
+
+    for (i = 0; i < 75; i++)
+    {
+        sim_advance(period / 2 + 3);
+        (void)TimerLib_GetTimestamp_tick();
+    }
+    before = TimerLib_GetTimestamp_tick();
+
+    TimerLib_ClockChangeBegin();
+    sim.running = false;
+    sim_advance(3 * period);
+    TimerLib_ClockChangeEnd(arr, to);
+    sim.running = true;
+
+    now0 = sim_now();
+    TimerLib_Delay_ns(500000);
+    elapsed = sim_now() - now0;
+    need = (uint64_t)500000 * to / 1000000000;
+    SIM_CHECK(elapsed >= need);
+    SIM_CHECK(elapsed <= need + period);
+
+    // 早于切换的时刻已经过去(时间线在切换时按新频率重新标定)
+    now0 = sim_now();
+    TimerLib_DelayUntil_tick(before * to / from / 2);
+    SIM_CHECK(sim_now() - now0 < period);
+
+    TimerLib_SetIdleHook(0);
+}
+
+int main(void)
+{
+    uint32_t seed;
+
+    for (seed = 0; seed < 20; seed++)
+    {
+        run(999, 10, seed);
+        run(7199, 3, seed + 100);
+        run(65535, 1, seed + 200);
+    }
+
+    // 升频与降频
+    sleep_after_switch(999, 36000000, 72000000);
+    sleep_after_switch(999, 72000000, 36000000);
+    sleep_after_switch(7199, 16000000, 170000000);
+    sleep_after_switch(7199, 170000000, 16000000);
+
+    printf("%s: %s\n", __FILE__, sim_failures ? "FAILED" : "ok");
+    return sim_failures != 0;
+}
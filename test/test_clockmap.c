@@ -0,0 +1,137 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file test_clockmap.c
+ * @brief 时钟域换算测试: 样本来自已知的线性关系(频率比带ppm偏差、整数截断、可选噪声),
+ *        窗口内换算误差不超过误差界, 漂移估计接近真值, 反向拟合的换算与正向互逆
+ */
+#include "TimerLib_ClockMap.h"
+#include "tim.h"
+#include <math.h>
+#include <stdlib.h>
+
+typedef struct
+{
+    uint32_t src_freq;
+    uint32_t dst_freq;
+    int32_t ppm;      // 目标时钟相对标称值的偏差
+    uint32_t noise;   // 目标读数噪声(±tick)
+    uint64_t src0;    // 首个样本的源时钟读数
+    uint64_t dst0;    // 首个样本的目标时钟读数
+} Case;
+
+static double ratio;  // 真实频率比 目标/源
+static const Case *c;
+
+// 已知线性关系: 距首个样本d个源tick时的目标时钟读数(未取整)
+static double truth(uint64_t d)
+{
+    return (double)c->dst0 + (double)d * ratio;
+}
+
+static int64_t error(uint64_t got, uint64_t d)
+{
+    return (int64_t)(got - c->dst0) - (int64_t)llround((double)d * ratio);
+}
+
+static void run(const Case *cs, uint32_t seed)
+{
+    TimerLib_ClockMap map, inv;
+    uint64_t spacing = cs->src_freq; // 每秒一对样本
+    uint64_t span = spacing * (TIMERLIB_CLOCKMAP_WINDOW - 1);
+    int64_t drift;
+    uint64_t y;
+    uint32_t k;
+
+    c = cs;
+    srand(seed);
+    ratio = (double)cs->dst_freq / cs->src_freq * (1.0 + cs->ppm * 1e-6);
+    TimerLib_ClockMap_Init(&map, cs->src_freq, cs->dst_freq);
+    TimerLib_ClockMap_Init(&inv, cs->dst_freq, cs->src_freq);
+
+    // 样本不足两个时按标称频率比换算: 一秒的源tick对应一秒的目标tick, Q32频率比截断最多少1个tick
+    y = TimerLib_ClockMap_Convert(&map, cs->src0 + cs->src_freq) - TimerLib_ClockMap_Convert(&map, cs->src0);
+    SIM_CHECK(y == cs->dst_freq || y + 1 == cs->dst_freq);
+
+    for (k = 0; k < TIMERLIB_CLOCKMAP_WINDOW; k++)
+    {
+        uint64_t d = k * spacing;
+        int64_t noise = (cs->noise != 0) ? (int64_t)(rand() % (2 * cs->noise + 1)) - cs->noise : 0;
+        uint64_t dst = (uint64_t)floor(truth(d) - (double)c->dst0) + c->dst0 + (uint64_t)noise;
+
+        TimerLib_ClockMap_AddSample(&map, cs->src0 + d, dst);
+        TimerLib_ClockMap_AddSample(&inv, dst, cs->src0 + d);
+    }
+
+    // 误差界覆盖窗口内任意时刻相对真实直线的偏差(另加1个tick的截断)
+    for (k = 0; k < 1000; k++)
+    {
+        uint64_t d = ((uint64_t)rand() << 31 ^ (uint64_t)rand()) % (span + 1);
+        uint64_t x;
+        int64_t e;
+        // 目标tick的误差换算到源时钟放大1/ratio倍
+        double back_bound = TimerLib_ClockMap_ErrorBound(&inv) + TimerLib_ClockMap_ErrorBound(&map) / ratio + 1;
+
+        y = TimerLib_ClockMap_Convert(&map, cs->src0 + d);
+        e = error(y, d);
+        SIM_CHECK(llabs(e) <= (int64_t)TimerLib_ClockMap_ErrorBound(&map) + 1);
+
+        // 反向换算回源时钟
+        x = TimerLib_ClockMap_Convert(&inv, y);
+        SIM_CHECK(fabs((double)(int64_t)(x - (cs->src0 + d))) <= back_bound);
+    }
+
+    // 无噪声时误差界只含取整, 有噪声时不超过噪声幅度加取整
+    SIM_CHECK(TimerLib_ClockMap_ErrorBound(&map) <= cs->noise * 2 + 3);
+
+    // 漂移估计: 窗口跨度内噪声与截断引起的斜率误差约为 (噪声+1)/跨度
+    drift = TimerLib_ClockMap_GetDrift_ppb(&map);
+    SIM_CHECK(llabs(drift - (int64_t)cs->ppm * 1000) <=
+              (int64_t)(2e9 * (cs->noise + 1) / ((double)span * ratio)) + 1);
+
+    printf("  %9u -> %9u Hz %+5d ppm noise %2u: drift %+8d ppb, error bound %u / %u\n", cs->src_freq, cs->dst_freq,
+           cs->ppm, cs->noise, (int)drift, TimerLib_ClockMap_ErrorBound(&map), TimerLib_ClockMap_ErrorBound(&inv));
+}
+
+int main(void)
+{
+    static const Case cases[] = {
+        {72000000, 32768, 50, 0, 0, 0},
+        {72000000, 32768, -120, 0, 123456789, 987654321},
+        {32768, 72000000, 20, 0, 5, 1000},
+        {72000000, 16000000, 0, 0, 0, 0},
+        {72000000, 16000000, 35, 3, 1000, 0},
+        {170000000, 1000000000, -80, 10, 0, 42},
+        // 源时钟读数在窗口中间跨越2^64回绕
+        {72000000, 32768, 50, 0, UINT64_MAX - 5 * 72000000ull, 0},
+    };
+
+    for (uint32_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        run(&cases[i], i + 1);
+    }
+
+    printf("%s: %s\n", __FILE__, sim_failures ? "FAILED" : "ok");
+    return sim_failures != 0;
+}
@@ -0,0 +1,173 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_counter.c
+ * @brief 计数器扩展测试: 随机读取间隔下时间戳与间隔(含16位紧凑句柄)必须与模拟计数器完全一致
+ *
+ * 同一源文件分别以默认、TIMERLIB_SOFT_OVERFLOW、TIMERLIB_REPETITION编译运行。
+ * 软件扩展模式下同时检查看门狗: 读取间隔小于溢出周期时违例标志保持清零,
+ * 达到一个溢出周期未读取时必须置位。
+ */
+#include "TimerLib.h"
+#include "tim.h"
+#include <stdlib.h>
+
+#if defined(TIMERLIB_SOFT_OVERFLOW) || defined(TIMERLIB_REPETITION)
+#define TIMERLIB_SOFT_WRAPS_TEST
+#endif
+
+static void run(uint32_t arr, uint32_t rep, uint32_t seed)
+{
+    uint64_t period = (uint64_t)arr + 1;
+    uint64_t prev = 0;
+    TimerLib_Handle h;
+    TimerLib_Handle16 h16;
+    uint64_t h_start, h16_start;
+    bool use16 = (period <= 65536); // 紧凑句柄只适用于不超过16位的溢出周期
+    int next16;
+    int i;
+
+    srand(seed);
+    sim_reset(period, 1 + (uint32_t)(period / 1000));
+#if defined(TIMERLIB_SOFT_OVERFLOW)
+    (void)rep;
+    sim.irq_enabled = false;
+#elif defined(TIMERLIB_REPETITION)
+    sim.rep = rep;
+#else
+    (void)rep;
+#endif
+    TimerLib_GlobalInit(arr, 72000000);
+#ifdef TIMERLIB_REPETITION
+    TimerLib_SetRepetition(rep - 1);
+#endif
+
+    TimerLib_InitHandle(&h);
+    h_start = sim_now();
+    TimerLib_InitHandle16(&h16);
+    h16_start = sim_now();
+    next16 = 1;
+    for (i = 0; i < 200000; i++)
+    {
+        // 两次读取之间的推进量(含读取本身的step)必须小于一个溢出周期
+        uint64_t limit = period - 1 - sim.step;
+        uint64_t gap = ((uint64_t)rand() << 31 | (uint64_t)rand()) % (limit + 1);
+        uint64_t ts;
+
+        if (rand() % 4 == 0)
+        {
+            gap = rand() % 3;  // 密集读取
+        }
+        else if (rand() % 4 == 0)
+        {
+            gap = limit - rand() % 3;  // 接近一个溢出周期, 相邻两次读取各跨越一次回绕
+        }
+        sim_advance(gap);
+#ifdef TIMERLIB_SOFT_WRAPS_TEST
+        // 上次读取本身推进了step, 再加上gap, 即距上次采样的tick数
+        TimerLib_SoftOverflowWatchdog((uint32_t)(gap + sim.step));
+#endif
+        ts = TimerLib_GetTimestamp_tick();
+        SIM_CHECK(ts == sim_now());
+        SIM_CHECK(ts >= prev);
+        prev = ts;
+
+        if (i % 1000 == 999)
+        {
+            uint32_t ns = TimerLib_GetInterval_ns(&h);
+            uint64_t expect = (sim_now() - h_start) * 1000000000ull / 72000000;
+
+            // 间隔只对不超过2^32 tick有意义
+            if (sim_now() - h_start < ((uint64_t)1 << 32) && expect < UINT32_MAX)
+            {
+                SIM_CHECK(ns + 1 >= expect && ns <= expect + 1);
+            }
+            TimerLib_InitHandle(&h);
+            h_start = sim_now();
+        }
+
+        // 紧凑句柄相隔1~65536次读取取一次间隔, 长度按2的幂分布, 最长约3万个溢出周期,
+        // 覆盖溢出计数差超过8位的情况, 且不超过句柄可测量的65536个溢出周期
+        if (use16 && i == next16)
+        {
+            uint64_t expect;
+
+            if (rand() % 2 == 0)
+            {
+                uint32_t ticks = TimerLib_GetInterval16_ticks(&h16);
+
+                expect = sim_now() - h16_start;
+                SIM_CHECK(ticks == expect);
+            }
+            else
+            {
+                uint32_t us = TimerLib_GetInterval16_us(&h16);
+
+                expect = (sim_now() - h16_start) * 1000000 / 72000000;
+                SIM_CHECK(us == expect);
+            }
+            h16_start = sim_now();
+            next16 = i + (1 << (rand() % 17));
+        }
+    }
+
+#ifdef TIMERLIB_SOFT_WRAPS_TEST
+    SIM_CHECK(!TimerLib_SoftOverflowViolated(false));
+
+    // 周期性上下文每1/4溢出周期调用一次看门狗(各测试周期都能被4整除);
+    // 3/4个周期未读取时不报告, 满一个周期未读取时期间的回绕可能丢失, 必须报告
+    TimerLib_SoftOverflowWatchdog(sim.step);
+    for (i = 0; i < 4; i++)
+    {
+        SIM_CHECK(!TimerLib_SoftOverflowViolated(false));
+        sim_advance(period / 4);
+        TimerLib_SoftOverflowWatchdog((uint32_t)(period / 4));
+    }
+    SIM_CHECK(TimerLib_SoftOverflowViolated(true));
+    SIM_CHECK(!TimerLib_SoftOverflowViolated(false));
+
+    // 恢复正常读取后不再置位
+    (void)TimerLib_GetTimestamp_tick();
+    TimerLib_SoftOverflowWatchdog(sim.step);
+    SIM_CHECK(!TimerLib_SoftOverflowViolated(false));
+#endif
+}
+
+int main(void)
+{
+    static const uint32_t arrs[] = {71, 999, 7199, 32767, 65535, 0xFFFFFFFF};
+    uint32_t i;
+
+    for (i = 0; i < sizeof(arrs) / sizeof(arrs[0]); i++)
+    {
+        run(arrs[i], 1, i);
+        run(arrs[i], 3, i + 300);
+        run(arrs[i], 10, i + 100);
+        run(arrs[i], 100, i + 200);
+    }
+
+    printf("%s: %s\n", __FILE__, sim_failures ? "FAILED" : "ok");
+    return sim_failures != 0;
+}
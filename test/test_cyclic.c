@@ -0,0 +1,179 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file test_cyclic.c
+ * @brief 循环执行器测试: 展开后的分派顺序与逐任务取模一致, 次帧按时启动,
+ *        超时计入对应次帧位置, 无效调度表被拒绝
+ */
+#include "TimerLib_Cyclic.h"
+#include "tim.h"
+
+#define MAJOR_RUNS 3
+#define MAX_CALLS 256
+
+typedef struct
+{
+    uint32_t task;  // 调度表中的下标
+    uint64_t ticks; // 调用时刻
+} Call;
+
+static Call calls[MAX_CALLS];
+static uint32_t call_count;
+static uint32_t overrun_ticks; // 非0时task 2在下一次调用中额外占用的时间
+
+static void record(uint32_t task)
+{
+    if (call_count < MAX_CALLS)
+    {
+        calls[call_count].task = task;
+        calls[call_count].ticks = sim_now();
+        call_count++;
+    }
+}
+
+static void task0(void) { record(0); }
+static void task1(void) { record(1); }
+static void task2(void)
+{
+    record(2);
+    sim_advance(overrun_ticks);
+    overrun_ticks = 0;
+}
+static void task3(void) { record(3); }
+
+static const TimerLib_CyclicTask tasks[] = {
+    TIMERLIB_CYCLIC_TASK(task0, 1, 0),
+    TIMERLIB_CYCLIC_TASK(task1, 2, 1),
+    TIMERLIB_CYCLIC_TASK(task2, 10, 3),
+    TIMERLIB_CYCLIC_TASK(task3, 5, 0),
+};
+
+/**
+ * @brief 按调度表逐任务取模得到第frame个次帧的调用序列, 与记录的调用逐一比较
+ */
+static uint32_t check_frame(uint32_t frame, uint32_t first)
+{
+    for (uint32_t i = 0; i < TIMERLIB_CYCLIC_COUNT(tasks); i++)
+    {
+        if (frame % tasks[i].period == tasks[i].offset)
+        {
+            SIM_CHECK(first < call_count && calls[first].task == i);
+            first++;
+        }
+    }
+    return first;
+}
+
+static void schedule(void)
+{
+    TimerLib_Cyclic ce;
+    uint32_t frame_first[10];
+    uint32_t pos = 0;
+    uint64_t start;
+
+    call_count = 0;
+    SIM_CHECK(TimerLib_Cyclic_Init(&ce, tasks, TIMERLIB_CYCLIC_COUNT(tasks), 1000) == 0);
+    SIM_CHECK(ce.major_frames == 10);
+    SIM_CHECK(ce.minor_ticks == 72000);
+
+    TimerLib_Cyclic_Start(&ce);
+    start = ce.deadline;
+    for (uint32_t f = 0; f < MAJOR_RUNS * ce.major_frames; f++)
+    {
+        uint32_t first = call_count;
+
+        SIM_CHECK(!TimerLib_Cyclic_RunFrame(&ce));
+        pos = check_frame(f, pos);
+        SIM_CHECK(pos == call_count);
+
+        // 帧内第一个任务在次帧起点之后的几次读取内启动
+        SIM_CHECK(first < call_count);
+        if (first < call_count)
+        {
+            uint64_t frame_start = start + (uint64_t)f * ce.minor_ticks;
+
+            SIM_CHECK(calls[first].ticks >= frame_start && calls[first].ticks <= frame_start + 4 * sim.step);
+        }
+    }
+    SIM_CHECK(ce.frames == MAJOR_RUNS * ce.major_frames);
+    SIM_CHECK(ce.overruns == 0);
+    SIM_CHECK(ce.jitter_max <= 4 * sim.step);
+
+    // task2在第3帧占用1.5个次帧: 第3帧计为超时, 落后的第4帧立即执行且未超出其结束时刻,
+    // 第5帧重新对齐到帧时刻
+    overrun_ticks = ce.minor_ticks * 3 / 2;
+    TimerLib_Cyclic_Start(&ce);
+    start = ce.deadline;
+    call_count = 0;
+    pos = 0;
+    for (uint32_t f = 0; f < ce.major_frames; f++)
+    {
+        frame_first[f] = call_count;
+        SIM_CHECK(TimerLib_Cyclic_RunFrame(&ce) == (f == 3));
+        pos = check_frame(f, pos);
+    }
+    SIM_CHECK(ce.overruns == 1);
+    SIM_CHECK(ce.slot_overruns[3] == 1 && ce.slot_overruns[4] == 0);
+    SIM_CHECK(ce.last_overrun_frame == 3);
+    SIM_CHECK(calls[frame_first[4]].ticks >= start + 4 * (uint64_t)ce.minor_ticks + ce.minor_ticks / 2);
+    SIM_CHECK(calls[frame_first[5]].ticks >= start + 5 * (uint64_t)ce.minor_ticks);
+    SIM_CHECK(calls[frame_first[5]].ticks <= start + 5 * (uint64_t)ce.minor_ticks + 4 * sim.step);
+}
+
+static void invalid(void)
+{
+    TimerLib_Cyclic ce;
+    static const TimerLib_CyclicTask bad_offset[] = {TIMERLIB_CYCLIC_TASK(task0, 4, 4)};
+    static const TimerLib_CyclicTask bad_period[] = {TIMERLIB_CYCLIC_TASK(task0, 0, 0)};
+    // 7与9的最小公倍数63超过TIMERLIB_CYCLIC_MAX_FRAMES
+    static const TimerLib_CyclicTask too_long[] = {
+        TIMERLIB_CYCLIC_TASK(task0, 7, 0),
+        TIMERLIB_CYCLIC_TASK(task1, 9, 0),
+    };
+    // 32个次帧 x 每帧3次调用超过TIMERLIB_CYCLIC_MAX_DISPATCH
+    static const TimerLib_CyclicTask too_many[] = {
+        TIMERLIB_CYCLIC_TASK(task0, 1, 0),
+        TIMERLIB_CYCLIC_TASK(task1, 1, 0),
+        TIMERLIB_CYCLIC_TASK(task3, 1, 0),
+        TIMERLIB_CYCLIC_TASK(task2, 32, 0),
+    };
+
+    SIM_CHECK(TimerLib_Cyclic_Init(&ce, bad_offset, 1, 1000) == -1);
+    SIM_CHECK(TimerLib_Cyclic_Init(&ce, bad_period, 1, 1000) == -1);
+    SIM_CHECK(TimerLib_Cyclic_Init(&ce, too_long, 2, 1000) == -1);
+    SIM_CHECK(TimerLib_Cyclic_Init(&ce, too_many, 4, 1000) == -1);
+    SIM_CHECK(TimerLib_Cyclic_Init(&ce, tasks, TIMERLIB_CYCLIC_COUNT(tasks), 0) == -1);
+}
+
+int main(void)
+{
+    sim_reset(65536, 1);
+    TimerLib_GlobalInit(65535, 72000000);
+
+    schedule();
+    invalid();
+
+    printf("%s: %s\n", __FILE__, sim_failures ? "FAILED" : "ok");
+    return sim_failures != 0;
+}
@@ -0,0 +1,216 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file test_defer.c
+ * @brief 延迟回调队列测试: 中断中压入、执行顺序、队列满与槽位复用、执行期间继续压入,
+ *        并比较中断内直接执行与延迟执行时的中断占用时间
+ *
+ * 模拟定时器1MHz(1 tick = 1us), 更新中断中的用户服务由sim.on_irq模拟。
+ */
+#include "TimerLib_Defer.h"
+#include "tim.h"
+#include <time.h>
+
+#define WORK_COST 300 // 每个回调的执行耗时(tick)
+
+static uint32_t posted, executed, next_expected, order_errors;
+
+// 回调参数为压入序号, 执行顺序必须与压入顺序一致
+static void work(void *arg)
+{
+    if ((uint32_t)(uintptr_t)arg != next_expected)
+    {
+        order_errors++;
+    }
+    next_expected = (uint32_t)(uintptr_t)arg + 1;
+    executed++;
+    sim_advance(WORK_COST);
+}
+
+static void nop(void *arg)
+{
+    (void)arg;
+}
+
+static void isr_post(void)
+{
+    if (TimerLib_Defer_Push(work, (void *)(uintptr_t)posted) == 0)
+    {
+        posted++;
+    }
+}
+
+static void start(void)
+{
+    sim_reset(1000, 1);
+    TimerLib_GlobalInit(999, 1000000);
+    TimerLib_Defer_Init();
+    posted = 0;
+    executed = 0;
+    next_expected = 0;
+    order_errors = 0;
+}
+
+static void test_order_and_full(void)
+{
+    start();
+
+    // 中断中压入, 主循环按压入顺序执行
+    sim.on_irq = isr_post;
+    sim_advance(10 * 1000);
+    sim.on_irq = 0;
+    SIM_CHECK(posted == 10);
+    SIM_CHECK(TimerLib_Defer_Dispatch(0) == 10);
+    SIM_CHECK(executed == 10 && order_errors == 0);
+
+    // 填满后压入失败并计入丢弃数, 取走后槽位可再次使用; 多轮覆盖所有槽位的序号回绕
+    for (int lap = 0; lap < 5; lap++)
+    {
+        for (int i = 0; i < TIMERLIB_DEFER_QUEUE_SIZE; i++)
+        {
+            isr_post();
+        }
+        SIM_CHECK(TimerLib_Defer_Push(work, 0) == -1);
+        SIM_CHECK(TimerLib_Defer_GetDropped() == (uint32_t)lap + 1);
+        SIM_CHECK(TimerLib_Defer_Dispatch(0) == TIMERLIB_DEFER_QUEUE_SIZE);
+        SIM_CHECK(TimerLib_Defer_Dispatch(0) == 0);
+    }
+    SIM_CHECK(executed == posted && order_errors == 0);
+}
+
+static void test_drain_while_posting(void)
+{
+    const uint32_t budget = 2000;
+    uint32_t rounds = 0;
+
+    start();
+
+    // 回调推进时间触发更新中断, 中断继续压入; 每次执行受预算限制
+    sim.on_irq = isr_post;
+    while (posted < 2000)
+    {
+        uint64_t t0 = sim_now();
+
+        (void)TimerLib_Defer_Dispatch(budget);
+        // 预算在回调之后检查, 最多超出一个回调
+        SIM_CHECK(sim_now() - t0 < budget + WORK_COST + 10);
+        sim_advance(100);
+        rounds++;
+    }
+    sim.on_irq = 0;
+    while (TimerLib_Defer_Dispatch(0) != 0)
+    {
+    }
+
+    SIM_CHECK(TimerLib_Defer_GetDropped() == 0);
+    SIM_CHECK(executed == posted && order_errors == 0);
+    SIM_CHECK(rounds > 1);
+}
+
+static uint64_t isr_max, isr_total, isr_count;
+
+static void isr_direct(void)
+{
+    uint64_t t0 = sim_now();
+
+    work((void *)(uintptr_t)posted++);
+    isr_total += sim_now() - t0;
+    isr_max = (sim_now() - t0 > isr_max) ? sim_now() - t0 : isr_max;
+    isr_count++;
+}
+
+static void isr_deferred(void)
+{
+    uint64_t t0 = sim_now();
+
+    isr_post();
+    isr_total += sim_now() - t0;
+    isr_max = (sim_now() - t0 > isr_max) ? sim_now() - t0 : isr_max;
+    isr_count++;
+}
+
+static uint64_t host_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief 中断占用时间: 直接在中断中执行回调与只压入队列相比
+ */
+static void test_isr_duration(void)
+{
+    uint64_t direct_max, t0, push_ns = 0;
+    uint32_t n = 0;
+
+    start();
+    isr_max = isr_total = isr_count = 0;
+    sim.on_irq = isr_direct;
+    sim_advance(100 * 1000);
+    sim.on_irq = 0;
+    direct_max = isr_max;
+    printf("  ISR direct:   %llu irqs, max %llu ticks, mean %llu ticks\n", (unsigned long long)isr_count,
+           (unsigned long long)isr_max, (unsigned long long)(isr_total / isr_count));
+
+    start();
+    isr_max = isr_total = isr_count = 0;
+    sim.on_irq = isr_deferred;
+    for (int i = 0; i < 100; i++)
+    {
+        sim_advance(1000);
+        (void)TimerLib_Defer_Dispatch(0);
+    }
+    sim.on_irq = 0;
+    printf("  ISR deferred: %llu irqs, max %llu ticks, mean %llu ticks\n", (unsigned long long)isr_count,
+           (unsigned long long)isr_max, (unsigned long long)(isr_total / isr_count));
+    SIM_CHECK(isr_max < direct_max);
+    SIM_CHECK(executed == posted && order_errors == 0);
+
+    // 主机上中断一侧压入一个回调的实际耗时, 每压满一次队列在计时之外取出
+    TimerLib_Defer_Init();
+    for (int i = 0; i < 1000000 / TIMERLIB_DEFER_QUEUE_SIZE; i++)
+    {
+        t0 = host_ns();
+        for (int j = 0; j < TIMERLIB_DEFER_QUEUE_SIZE; j++)
+        {
+            n += (TimerLib_Defer_Push(nop, 0) == 0);
+        }
+        push_ns += host_ns() - t0;
+        (void)TimerLib_Defer_Dispatch(0);
+    }
+    printf("  host push: %llu ps per callback\n", (unsigned long long)(push_ns * 1000 / n));
+    SIM_CHECK(n == 1000000 / TIMERLIB_DEFER_QUEUE_SIZE * TIMERLIB_DEFER_QUEUE_SIZE);
+}
+
+int main(void)
+{
+    test_order_and_full();
+    test_drain_while_posting();
+    test_isr_duration();
+
+    printf("%s: %s\n", __FILE__, sim_failures ? "FAILED" : "ok");
+    return sim_failures != 0;
+}
@@ -0,0 +1,209 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_delay.c
+ * @brief 延时下限测试: 统一延时入口、纳秒与微秒延时的实际耗时不得短于请求的tick数,
+ *        延时结束后时间戳仍与模拟定时器一致; 以主机时钟计数时检查空循环延时的精度
+ */
+#include "TimerLib.h"
+#include "tim.h"
+#include <stdlib.h>
+
+static uint32_t rand32(void)
+{
+    return (uint32_t)rand() << 16 ^ (uint32_t)rand();
+}
+
+static void run(uint32_t arr, uint32_t clk_freq, uint32_t seed)
+{
+    uint64_t period = (uint64_t)arr + 1;
+    int i;
+
+    srand(seed);
+    sim_reset(period, 1 + (uint32_t)(period / 100));
+#if defined(TIMERLIB_SOFT_OVERFLOW)
+    sim.irq_enabled = false;
+#elif defined(TIMERLIB_REPETITION)
+    sim.rep = 3;
+#endif
+    TimerLib_GlobalInit(arr, clk_freq);
+#ifdef TIMERLIB_REPETITION
+    TimerLib_SetRepetition(2);
+#endif
+
+    for (i = 0; i < 200; i++)
+    {
+        // 多数为短延时, 少数为长延时; 短溢出周期下每次读取推进量小, 长延时上限收紧以控制运行时间
+        uint32_t ns = rand32() % 100000;
+        if (i == 0)
+        {
+            ns = UINT32_MAX;  // 换算误差随延时增大, 最长延时最容易暴露偏短
+        }
+        else if (i % 25 == 0)
+        {
+            ns = (period >= 65536) ? rand32() : rand32() % 100000000;
+        }
+        uint64_t expect = (uint64_t)ns * clk_freq / 1000000000;
+        uint64_t start;
+        uint32_t us;
+
+        // 距上次读取接近一个溢出周期时开始延时, 延时中的回绕只能由延时本身的读取发现
+        sim_advance(period - 1 - sim.step - rand() % 3);
+
+        start = sim_now();
+        TimerLib_Delay_ns(ns);
+        SIM_CHECK(sim_now() - start >= expect);
+
+        start = sim_now();
+        TimerLib_DelayNS(ns);
+        SIM_CHECK(sim_now() - start >= expect);
+
+        // 微秒延时限制在2ms以内控制运行时间; us*频率在us > 59时已超过32位
+        us = ns / 1000 % 2000;
+        expect = (uint64_t)us * clk_freq / 1000000;
+        start = sim_now();
+        TimerLib_DelayUS(us);
+        SIM_CHECK(sim_now() - start >= expect);
+
+        start = sim_now();
+        TimerLib_DelayUS_32(us);
+        SIM_CHECK(sim_now() - start >= expect);
+
+        // 延时期间的回绕必须全部记入时间戳(软件回绕检测依赖延时中的读取)
+        SIM_CHECK(TimerLib_GetTimestamp_tick() == sim_now());
+    }
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 以主机时钟计数时测量DelayNS的中位耗时(tick), 扣除前后两次读取本身的开销
+ */
+static uint64_t median_delay(uint32_t ns)
+{
+    uint64_t t[101], base[101];
+
+    for (int i = 0; i < 101; i++)
+    {
+        uint64_t start;
+
+        (void)sim_read();
+        start = sim_now();
+        (void)sim_read();
+        base[i] = sim_now() - start;
+
+        (void)sim_read();
+        start = sim_now();
+        TimerLib_DelayNS(ns);
+        (void)sim_read();
+        t[i] = sim_now() - start;
+    }
+    qsort(t, 101, sizeof(t[0]), cmp_u64);
+    qsort(base, 101, sizeof(base[0]), cmp_u64);
+    return (t[50] > base[50]) ? t[50] - base[50] : 0;
+}
+
+/**
+ * @brief 检查空循环范围内各延时的中位耗时与请求值的偏差不超过请求值的一半加上限的1/4
+ */
+static bool spin_accurate(uint32_t limit)
+{
+    for (uint32_t part = 1; part <= 3; part++)
+    {
+        uint32_t ns = limit * part / 4;
+        uint64_t median = median_delay(ns);
+
+        if (median + ns / 2 + limit / 4 < ns || median > ns + ns / 2 + limit / 4)
+        {
+            printf("%s: spin %u ns took %llu ns (limit %u ns)\n", __FILE__, ns, (unsigned long long)median, limit);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 空循环延时: 计数器按主机时钟以1GHz前进(1 tick = 1ns), 校准后空循环范围内的延时接近请求值;
+ *        切换时钟后校准被清除, 延时改为轮询, 不得偏短
+ * @note 主机的内核频率与调度会使空循环速度在数十%内波动, 精度检查失败时重新校准, 三次均失败才算失败
+ */
+static void spin_case(void)
+{
+    uint32_t limit = 0;
+    bool accurate = false;
+
+    sim_reset((uint64_t)1 << 32, 0);
+    TimerLib_GlobalInit(0xFFFFFFFF, 1000000000);
+    sim_use_host_clock(1000000000);
+    for (int attempt = 0; attempt < 3 && !accurate; attempt++)
+    {
+        TimerLib_CalibrateSpin();
+        limit = TimerLib_GetSpinLimit_ns();
+        accurate = (limit != 0) && spin_accurate(limit);
+    }
+    SIM_CHECK(accurate);
+
+    TimerLib_ClockChangeBegin();
+    TimerLib_ClockChangeEnd(0xFFFFFFFF, 500000000);
+    sim_use_host_clock(500000000);
+    SIM_CHECK(TimerLib_GetSpinLimit_ns() == 0);
+    for (int i = 0; i < 100; i++)
+    {
+        uint32_t ns = (limit != 0) ? limit / 2 : 100;
+        uint64_t start;
+
+        (void)sim_read();
+        start = sim_now();
+        TimerLib_DelayNS(ns);
+        SIM_CHECK(sim_now() - start >= (uint64_t)ns / 2);
+    }
+    sim_use_host_clock(0);
+}
+
+int main(void)
+{
+    static const uint32_t arrs[] = {999, 65535, 0xFFFFFFFF};
+    // 14745600Hz不是整MHz, 微秒延时走通用换算路径
+    static const uint32_t freqs[] = {72000000, 168000000, 170000000, 80000000, 14745600};
+    uint32_t i, j;
+
+    for (i = 0; i < sizeof(arrs) / sizeof(arrs[0]); i++)
+    {
+        for (j = 0; j < sizeof(freqs) / sizeof(freqs[0]); j++)
+        {
+            run(arrs[i], freqs[j], i * 10 + j);
+        }
+    }
+    spin_case();
+
+    printf("%s: %s\n", __FILE__, sim_failures ? "FAILED" : "ok");
+    return sim_failures != 0;
+}
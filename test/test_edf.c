@@ -0,0 +1,248 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file test_edf.c
+ * @brief EDF调度器测试: 截止期顺序、单次任务校验, 以及与固定顺序轮询相比的错过截止期次数
+ *
+ * 任务函数按执行耗时推进模拟定时器(1MHz, 1 tick = 1us)。
+ * 持续过载时EDF的错过次数可能多于轮询(多米诺效应), 该任务集只检查吞吐量。
+ */
+#include "TimerLib_EDF.h"
+#include "tim.h"
+
+#define HORIZON 500000 // 每个任务集运行的时长(tick)
+#define MAX_TASKS 8
+#define BURST_END 100000 // 过载窗口 [0, BURST_END) 内任务按burst_cost执行
+
+typedef struct
+{
+    uint32_t period_us;
+    uint32_t deadline_us;
+    uint32_t cost;
+    uint32_t burst_cost; // 过载窗口内的执行耗时, 0表示与cost相同
+} TaskSpec;
+
+static uint32_t order[MAX_TASKS];
+static uint32_t order_count;
+
+static void burn(void *ctx)
+{
+    const TaskSpec *spec = ctx;
+
+    if (spec->burst_cost != 0 && TimerLib_GetTimestamp_tick() < BURST_END)
+    {
+        sim_advance(spec->burst_cost);
+    }
+    else
+    {
+        sim_advance(spec->cost);
+    }
+}
+
+static void record(void *ctx)
+{
+    order[order_count++] = (uint32_t)(uintptr_t)ctx;
+}
+
+static void start(void)
+{
+    sim_reset(65536, 1);
+    TimerLib_GlobalInit(65535, 1000000);
+}
+
+static void idle_until(uint64_t release)
+{
+    uint64_t now = TimerLib_GetTimestamp_tick();
+
+    if (release != UINT64_MAX && release > now)
+    {
+        sim_advance(release - now);
+    }
+}
+
+static uint32_t run_edf(const TaskSpec *spec, uint32_t n, uint32_t *runs)
+{
+    TimerLib_EDFTask tasks[MAX_TASKS];
+    TimerLib_EDFTask *ready[MAX_TASKS], *waiting[MAX_TASKS];
+    TimerLib_EDF sched;
+
+    start();
+    TimerLib_EDF_Init(&sched, ready, waiting, MAX_TASKS);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        tasks[i].fn = burn;
+        tasks[i].ctx = (void *)&spec[i];
+        SIM_CHECK(TimerLib_EDF_Add(&sched, &tasks[i], spec[i].period_us, spec[i].deadline_us, 0) == 0);
+    }
+
+    while (TimerLib_GetTimestamp_tick() < HORIZON)
+    {
+        if (!TimerLib_EDF_RunOnce(&sched))
+        {
+            idle_until(TimerLib_EDF_NextRelease(&sched));
+        }
+    }
+    *runs = sched.runs;
+    return sched.misses;
+}
+
+/**
+ * @brief 对照组: 按固定顺序轮询, 已释放的任务依次执行, 错过截止期的判定与EDF相同
+ */
+static uint32_t run_round_robin(const TaskSpec *spec, uint32_t n, uint32_t *runs)
+{
+    uint64_t release[MAX_TASKS];
+    uint32_t misses = 0;
+
+    start();
+    *runs = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        release[i] = TimerLib_GetTimestamp_tick();
+    }
+
+    while (TimerLib_GetTimestamp_tick() < HORIZON)
+    {
+        uint64_t next = UINT64_MAX;
+        bool ran = false;
+
+        for (uint32_t i = 0; i < n; i++)
+        {
+            uint32_t deadline = (spec[i].deadline_us != 0) ? spec[i].deadline_us : spec[i].period_us;
+
+            if (release[i] <= TimerLib_GetTimestamp_tick())
+            {
+                burn((void *)&spec[i]);
+                if (TimerLib_GetTimestamp_tick() > release[i] + deadline)
+                {
+                    misses++;
+                }
+                release[i] += spec[i].period_us;
+                (*runs)++;
+                ran = true;
+            }
+            if (release[i] < next)
+            {
+                next = release[i];
+            }
+        }
+        if (!ran)
+        {
+            idle_until(next);
+        }
+    }
+    return misses;
+}
+
+/**
+ * @brief 预期结果: 不错过截止期 / 不多于轮询 / 持续过载(只要求吞吐量不低于轮询)
+ */
+typedef enum
+{
+    EXPECT_NO_MISS,
+    EXPECT_NOT_WORSE,
+    EXPECT_OVERLOAD,
+} Expect;
+
+static void compare(const char *name, const TaskSpec *spec, uint32_t n, Expect expect)
+{
+    uint32_t edf_runs, rr_runs;
+    uint32_t edf = run_edf(spec, n, &edf_runs);
+    uint32_t rr = run_round_robin(spec, n, &rr_runs);
+
+    printf("  %-12s EDF misses %4u / %4u runs, round-robin misses %4u / %4u runs\n", name, edf, edf_runs, rr,
+           rr_runs);
+    if (expect == EXPECT_OVERLOAD)
+    {
+        // 持续过载时EDF出现多米诺效应, 积压作业的截止期都已过去, 错过次数可能多于轮询
+        SIM_CHECK(edf_runs >= rr_runs);
+        return;
+    }
+    SIM_CHECK(edf <= rr);
+    if (expect == EXPECT_NO_MISS)
+    {
+        SIM_CHECK(edf == 0);
+    }
+}
+
+static void test_one_shot(void)
+{
+    TimerLib_EDFTask tasks[4];
+    TimerLib_EDFTask *ready[4], *waiting[4];
+    TimerLib_EDF sched;
+    static const uint32_t deadlines[] = {300, 100, 400, 200};
+
+    start();
+    TimerLib_EDF_Init(&sched, ready, waiting, 4);
+
+    // 单次任务必须指定截止期
+    tasks[0].fn = record;
+    tasks[0].ctx = 0;
+    SIM_CHECK(TimerLib_EDF_Add(&sched, &tasks[0], 0, 0, 0) == -1);
+
+    // 同时释放的单次任务按截止期执行, 且各执行一次
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        tasks[i].fn = record;
+        tasks[i].ctx = (void *)(uintptr_t)i;
+        SIM_CHECK(TimerLib_EDF_Add(&sched, &tasks[i], 0, deadlines[i], 0) == 0);
+    }
+    order_count = 0;
+    while (TimerLib_EDF_RunOnce(&sched))
+    {
+    }
+    SIM_CHECK(order_count == 4);
+    SIM_CHECK(order[0] == 1 && order[1] == 3 && order[2] == 0 && order[3] == 2);
+    SIM_CHECK(TimerLib_EDF_NextRelease(&sched) == UINT64_MAX);
+    SIM_CHECK(sched.misses == 0);
+}
+
+int main(void)
+{
+    // 利用率约0.74, 隐式截止期
+    static const TaskSpec light[] = {
+        {2000, 0, 150, 0}, {3000, 0, 400, 0}, {5000, 0, 700, 0}, {7000, 0, 1200, 0}, {11000, 0, 1500, 0},
+    };
+    // 利用率约0.95, 短周期任务的截止期短于周期
+    static const TaskSpec tight[] = {
+        {1000, 600, 100, 0}, {4000, 0, 1300, 0}, {5000, 0, 1500, 0}, {9000, 3000, 1700, 0},
+    };
+    // 前100ms利用率约1.03(短暂过载), 之后回落到约0.74
+    static const TaskSpec burst[] = {
+        {2000, 0, 150, 300}, {3000, 0, 400, 700}, {5000, 0, 700, 1100}, {7000, 0, 1200, 1600}, {11000, 0, 1500, 2200},
+    };
+    // 利用率约1.3, 持续过载
+    static const TaskSpec overload[] = {
+        {1000, 0, 250, 0}, {2000, 0, 600, 0}, {3000, 0, 900, 0}, {5000, 0, 1100, 0},
+    };
+
+    test_one_shot();
+    compare("light", light, sizeof(light) / sizeof(light[0]), EXPECT_NO_MISS);
+    compare("tight", tight, sizeof(tight) / sizeof(tight[0]), EXPECT_NOT_WORSE);
+    compare("burst", burst, sizeof(burst) / sizeof(burst[0]), EXPECT_NOT_WORSE);
+    compare("overload", overload, sizeof(overload) / sizeof(overload[0]), EXPECT_OVERLOAD);
+
+    printf("%s: %s\n", __FILE__, sim_failures ? "FAILED" : "ok");
+    return sim_failures != 0;
+}
@@ -0,0 +1,125 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_format.c
+ * @brief 格式化测试: 无除法实现的输出与按整数除法和printf得到的结果逐字符一致
+ */
+#include "TimerLib_Format.h"
+#include "tim.h"
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+static uint64_t rand64(void)
+{
+    uint64_t v = 0;
+    int i;
+
+    for (i = 0; i < 5; i++)
+    {
+        v = (v << 15) ^ (uint64_t)rand();
+    }
+    // 随机位宽, 覆盖各个数量级
+    return v >> (rand() % 64);
+}
+
+static void expect_duration(uint64_t ticks, uint32_t freq, char *out)
+{
+    uint64_t s = ticks / freq;
+    uint64_t ns = ticks % freq * 1000000000 / freq;
+
+    if (s == 0 && ns < 1000)
+    {
+        sprintf(out, "%" PRIu64 "ns", ns);
+    }
+    else if (s == 0 && ns < 1000000)
+    {
+        sprintf(out, "%" PRIu64 ".%03" PRIu64 "us", ns / 1000, ns % 1000);
+    }
+    else if (s == 0)
+    {
+        sprintf(out, "%" PRIu64 ".%03" PRIu64 "ms", ns / 1000000, ns / 1000 % 1000);
+    }
+    else if (s < 60)
+    {
+        sprintf(out, "%" PRIu64 ".%03" PRIu64 "s", s, ns / 1000000);
+    }
+    else if (s < 3600)
+    {
+        sprintf(out, "%" PRIu64 "m%02" PRIu64 "s", s / 60, s % 60);
+    }
+    else
+    {
+        sprintf(out, "%" PRIu64 "h%02" PRIu64 "m%02" PRIu64 "s", s / 3600, s / 60 % 60, s % 60);
+    }
+}
+
+static void run(uint32_t freq, uint32_t seed)
+{
+    char buf[TIMERLIB_FORMAT_MAX], ref[64];
+    int i;
+
+    srand(seed);
+    sim_reset(65536, 1);
+    TimerLib_GlobalInit(65535, freq);
+
+    for (i = 0; i < 200000; i++)
+    {
+        uint64_t v = (i == 0) ? UINT64_MAX : rand64();
+        uint32_t decimals = (uint32_t)rand() % 10;
+        uint64_t s = v / freq;
+        uint64_t ns = v % freq * 1000000000 / freq;
+
+        TimerLib_Format_U64(buf, sizeof(buf), v);
+        sprintf(ref, "%" PRIu64, v);
+        SIM_CHECK(strcmp(buf, ref) == 0);
+
+        TimerLib_Format_Seconds(buf, sizeof(buf), v, decimals);
+        sprintf(ref, "%" PRIu64 ".%09" PRIu64, s, ns);
+        ref[strlen(ref) - 9 + decimals - (decimals == 0)] = '\0';
+        SIM_CHECK(strcmp(buf, ref) == 0);
+
+        TimerLib_Format_Duration(buf, sizeof(buf), v);
+        expect_duration(v, freq, ref);
+        SIM_CHECK(strcmp(buf, ref) == 0);
+    }
+}
+
+int main(void)
+{
+    char buf[TIMERLIB_FORMAT_MAX];
+
+    run(72000000, 1);
+    run(1000000, 2);
+    run(4294967295u, 3);
+
+    // 最长时长: 超过2^32秒时时分换算也必须精确
+    TimerLib_GlobalInit(65535, 1000000);
+    TimerLib_Format_Duration(buf, sizeof(buf), UINT64_MAX);
+    SIM_CHECK(strcmp(buf, "5124095576h01m49s") == 0);
+
+    printf("%s: %s\n", __FILE__, sim_failures ? "FAILED" : "ok");
+    return sim_failures != 0;
+}
@@ -0,0 +1,196 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file test_instr.c
+ * @brief 自动函数计时测试: 嵌套调用的包含/自身耗时、停止与重新使能时的调用深度、递归与排除区间
+ *
+ * 本文件以 -finstrument-functions 编译, TimerLib与模拟器排除在插桩之外。
+ * 模拟计数器读取时不推进(step为0), 各函数的耗时即其中 sim_advance 的总和。
+ */
+#include "TimerLib_Instrument.h"
+#include "tim.h"
+
+#define NOINLINE __attribute__((noinline))
+
+typedef struct
+{
+    void *fn;
+    uint32_t calls;
+    uint64_t ticks;
+    uint64_t self;
+} Stat;
+
+static Stat stats[16];
+static uint32_t stat_count;
+
+static void collect(void *fn, uint32_t calls, uint64_t ticks, uint64_t self_ticks, void *ctx)
+{
+    (void)ctx;
+    if (stat_count < sizeof(stats) / sizeof(stats[0]))
+    {
+        stats[stat_count].fn = fn;
+        stats[stat_count].calls = calls;
+        stats[stat_count].ticks = ticks;
+        stats[stat_count].self = self_ticks;
+        stat_count++;
+    }
+}
+
+static const Stat *find(void *fn)
+{
+    for (uint32_t i = 0; i < stat_count; i++)
+    {
+        if (stats[i].fn == fn)
+        {
+            return &stats[i];
+        }
+    }
+    return 0;
+}
+
+static void dump(void)
+{
+    stat_count = 0;
+    TimerLib_Instr_Dump(collect, 0);
+}
+
+static void expect(void *fn, uint32_t calls, uint64_t ticks, uint64_t self)
+{
+    const Stat *s = find(fn);
+
+    SIM_CHECK(s != 0);
+    if (s != 0)
+    {
+        SIM_CHECK(s->calls == calls);
+        SIM_CHECK(s->ticks == ticks);
+        SIM_CHECK(s->self == self);
+    }
+}
+
+NOINLINE static void leaf(void)
+{
+    sim_advance(100);
+}
+
+NOINLINE static void mid(void)
+{
+    leaf();
+    sim_advance(50);
+    leaf();
+}
+
+NOINLINE static void top(void)
+{
+    sim_advance(10);
+    mid();
+}
+
+NOINLINE static void off_inside(void)
+{
+    sim_advance(5);
+    TimerLib_Instr_Enable(false);
+}
+
+NOINLINE static void on_inside(void)
+{
+    TimerLib_Instr_Enable(true);
+    sim_advance(7);
+}
+
+NOINLINE static void rec(int n)
+{
+    sim_advance(10);
+    if (n > 0)
+    {
+        rec(n - 1);
+    }
+    __asm__ volatile("" ::: "memory"); // 阻止尾调用优化
+}
+
+NOINLINE static void excluded(void)
+{
+    sim_advance(30);
+    leaf();
+}
+
+NOINLINE static void calls_excluded(void)
+{
+    sim_advance(10);
+    excluded();
+}
+
+int main(void)
+{
+    sim_reset((uint64_t)1 << 32, 0);
+    TimerLib_GlobalInit(0xFFFFFFFF, 72000000);
+
+    // 嵌套调用: 自身耗时扣除子函数, 包含耗时不扣除
+    TimerLib_Instr_Reset();
+    TimerLib_Instr_Enable(true);
+    top();
+    TimerLib_Instr_Enable(false);
+    dump();
+    expect((void *)top, 1, 260, 10);
+    expect((void *)mid, 1, 250, 50);
+    expect((void *)leaf, 2, 200, 200);
+    SIM_CHECK(stat_count == 3);
+
+    // 在函数内部停止、在另一个函数内部重新使能: 两者都不记录, 之后的调用仍正确配对
+    TimerLib_Instr_Reset();
+    TimerLib_Instr_Enable(true);
+    off_inside();
+    on_inside();
+    leaf();
+    top();
+    TimerLib_Instr_Enable(false);
+    dump();
+    SIM_CHECK(find((void *)off_inside) == 0);
+    SIM_CHECK(find((void *)on_inside) == 0);
+    expect((void *)leaf, 3, 300, 300);
+    expect((void *)top, 1, 260, 10);
+    SIM_CHECK(stat_count == 3);
+
+    // 递归: 包含耗时重复累计各层, 自身耗时不重复
+    TimerLib_Instr_Reset();
+    TimerLib_Instr_Enable(true);
+    rec(2);
+    TimerLib_Instr_Enable(false);
+    dump();
+    expect((void *)rec, 3, 30 + 20 + 10, 30);
+
+    // 排除的函数自身耗时计入调用者, 其中已记录的子函数不重复计入
+    TimerLib_Instr_Reset();
+    SIM_CHECK(TimerLib_Instr_Exclude((const void *)excluded, (const char *)(void *)excluded + 1) == 0);
+    TimerLib_Instr_Enable(true);
+    calls_excluded();
+    TimerLib_Instr_Enable(false);
+    dump();
+    SIM_CHECK(find((void *)excluded) == 0);
+    expect((void *)calls_excluded, 1, 140, 40);
+    expect((void *)leaf, 1, 100, 100);
+    SIM_CHECK(TimerLib_Instr_GetDropped() == 0);
+
+    printf("%s: %s\n", __FILE__, sim_failures ? "FAILED" : "ok");
+    return sim_failures != 0;
+}
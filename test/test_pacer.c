@@ -0,0 +1,81 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file test_pacer.c
+ * @brief 节拍器测试: 周期不是整数tick时长期平均周期等于精确值, 周期起点始终落在精确网格上
+ */
+#include "TimerLib_Pacer.h"
+#include "tim.h"
+#include <stdlib.h>
+
+#define ITERATIONS 100000
+
+static void run(uint32_t freq, uint32_t period_us, TimerLib_PacerPolicy policy, uint32_t seed)
+{
+    TimerLib_Pacer pacer;
+    uint64_t start, first, expect, elapsed;
+    double mean_us;
+
+    srand(seed);
+    // 每次读取推进约1/64个周期, 控制等待中的轮询次数
+    sim_reset(65536, 1 + (uint32_t)((uint64_t)period_us * freq / 1000000 / 64));
+    TimerLib_GlobalInit(65535, freq);
+
+    TimerLib_Pacer_Init(&pacer, period_us, policy);
+    start = pacer.deadline - (uint64_t)period_us * freq / 1000000;
+    (void)TimerLib_Pacer_Wait(&pacer);
+    first = sim_now();
+
+    for (uint32_t i = 1; i < ITERATIONS; i++)
+    {
+        // 偶尔工作耗时超过若干周期
+        if (rand() % 1000 == 0)
+        {
+            sim_advance((uint64_t)period_us * freq / 1000000 * (1 + rand() % 5));
+        }
+        (void)TimerLib_Pacer_Wait(&pacer);
+
+        // 第k个周期起点 = start + floor(k * period_us * freq / 1e6)
+        expect = start + (uint64_t)(1 + pacer.iterations + pacer.skipped) * period_us * freq / 1000000;
+        SIM_CHECK(pacer.deadline == expect);
+    }
+
+    elapsed = sim_now() - first;
+    mean_us = (double)elapsed * 1e6 / freq / (ITERATIONS - 1 + pacer.skipped);
+    printf("  %9u Hz %5u us %-7s: mean period %.4f us, %u overruns, %u skipped\n", freq, period_us,
+           policy == TIMERLIB_PACER_SKIP ? "skip" : "catchup", mean_us, pacer.overruns, pacer.skipped);
+    SIM_CHECK(mean_us > period_us - 0.01 && mean_us < period_us + 0.01);
+}
+
+int main(void)
+{
+    run(32768, 1000, TIMERLIB_PACER_SKIP, 1);
+    run(32768, 1000, TIMERLIB_PACER_CATCHUP, 2);
+    run(32768, 100, TIMERLIB_PACER_SKIP, 3);
+    run(1000000, 1000, TIMERLIB_PACER_SKIP, 4);
+    run(72000000, 333, TIMERLIB_PACER_CATCHUP, 5);
+
+    printf("%s: %s\n", __FILE__, sim_failures ? "FAILED" : "ok");
+    return sim_failures != 0;
+}
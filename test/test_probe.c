@@ -0,0 +1,102 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file test_probe.c
+ * @brief 采样模式探针测试: 采样次数、未采样执行不读定时器, 以及主机上单次探针的开销
+ *
+ * 以TIMERLIB_PROBE_SAMPLED、TIMERLIB_PROBE_SAMPLE_RATE=64编译。OFF模式不产生代码,
+ * 由test/Makefile的probe_size规则比较probe_unit.c插入与不插入探针的目标文件。
+ */
+#include "TimerLib_Probe.h"
+#include "tim.h"
+#include <time.h>
+
+#define RUNS (TIMERLIB_PROBE_SAMPLE_RATE * 1000)
+
+TIMERLIB_PROBE_DEFINE(section);
+TIMERLIB_PROBE_DEFINE(event);
+TIMERLIB_PROBE_DEFINE(host);
+
+static volatile uint32_t sink;
+
+static uint64_t host_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+}
+
+int main(void)
+{
+    const TimerLib_ProbeSlot *slot = TIMERLIB_PROBE_SLOT(section);
+    uint64_t reads, per_timestamp, t0, plain_ns, probed_ns;
+
+    sim_reset(65536, 1);
+    TimerLib_GlobalInit(65535, 72000000);
+
+    reads = sim.reads;
+    (void)TimerLib_GetTimestamp_tick();
+    per_timestamp = sim.reads - reads;
+
+    // 区间与事件各自每RATE次采样一次, 只有采样的执行读取定时器
+    reads = sim.reads;
+    for (uint32_t i = 0; i < RUNS; i++)
+    {
+        TIMERLIB_PROBE_BEGIN(section);
+        sim_advance(10);
+        TIMERLIB_PROBE_END(section);
+        TIMERLIB_PROBE_EVENT(event);
+    }
+    SIM_CHECK(slot->count == RUNS / TIMERLIB_PROBE_SAMPLE_RATE);
+    SIM_CHECK(slot->event_count == 0);
+    SIM_CHECK(TIMERLIB_PROBE_SLOT(event)->event_count == RUNS / TIMERLIB_PROBE_SAMPLE_RATE);
+    SIM_CHECK(TIMERLIB_PROBE_SLOT(event)->count == 0);
+    SIM_CHECK(sim.reads - reads == (uint64_t)RUNS / TIMERLIB_PROBE_SAMPLE_RATE * 3 * per_timestamp);
+    SIM_CHECK(slot->min_ticks >= 10 && slot->max_ticks <= 10 + 2 * per_timestamp * sim.step);
+
+    // 主机上的开销: 同一循环体加与不加采样探针
+    t0 = host_ns();
+    for (uint32_t i = 0; i < RUNS * 100; i++)
+    {
+        sink += i;
+    }
+    plain_ns = host_ns() - t0;
+    t0 = host_ns();
+    for (uint32_t i = 0; i < RUNS * 100; i++)
+    {
+        TIMERLIB_PROBE_BEGIN(host);
+        sink += i;
+        TIMERLIB_PROBE_END(host);
+    }
+    probed_ns = host_ns() - t0;
+    printf("  sampled probe (1/%d): %llu ps per BEGIN/END pair, %llu timer reads per %u executions\n",
+           TIMERLIB_PROBE_SAMPLE_RATE,
+           (unsigned long long)((probed_ns > plain_ns ? probed_ns - plain_ns : 0) * 1000 / (RUNS * 100)),
+           (unsigned long long)(2 * per_timestamp), TIMERLIB_PROBE_SAMPLE_RATE);
+    SIM_CHECK(TIMERLIB_PROBE_SLOT(host)->count == RUNS * 100 / TIMERLIB_PROBE_SAMPLE_RATE);
+
+    printf("%s: %s\n", __FILE__, sim_failures ? "FAILED" : "ok");
+    return sim_failures != 0;
+}
@@ -0,0 +1,110 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_sleep.c
+ * @brief 低功耗休眠计时测试: 定时器停止期间由低速时钟补偿, 唤醒后时间戳不得跳变
+ *
+ * 以默认、TIMERLIB_SOFT_OVERFLOW、TIMERLIB_REPETITION分别编译运行。
+ */
+#include "TimerLib.h"
+#include "tim.h"
+
+#define SLOW_DIV 64 // 低速时钟 = 定时器时钟 / 64
+
+static uint32_t slow_read(void)
+{
+    return (uint32_t)(sim.real / SLOW_DIV) & 0xFFFF;
+}
+
+static void run(uint32_t arr, uint32_t rep)
+{
+    int64_t offset;
+    int round, i;
+
+    sim_reset((uint64_t)arr + 1, 1);
+#if defined(TIMERLIB_SOFT_OVERFLOW)
+    (void)rep;
+    sim.irq_enabled = false;
+#elif defined(TIMERLIB_REPETITION)
+    sim.rep = rep;
+#else
+    (void)rep;
+#endif
+    TimerLib_GlobalInit(arr, 72000000);
+#ifdef TIMERLIB_REPETITION
+    TimerLib_SetRepetition(rep - 1);
+#endif
+    TimerLib_SlowClock_Config(slow_read, 72000000 / SLOW_DIV, 16);
+
+    // 休眠前的若干更新中断, 使重复计数器处于任意相位
+    for (i = 0; i < 1000 + (int)rep * 37; i++)
+    {
+        TimerLib_GetTimestamp_tick();
+    }
+
+    for (round = 0; round < 20; round++)
+    {
+        TimerLib_Handle h;
+        uint64_t real0, ts0, ts, prev;
+        uint64_t asleep = 100000 + (uint64_t)round * 12347;
+
+        TimerLib_InitHandle(&h);
+        real0 = sim.real;
+        ts0 = TimerLib_GetTimestamp_tick();
+
+        TimerLib_SleepEnter();
+        sim.running = false;
+        sim_advance(asleep);
+        sim.running = true;
+        SIM_CHECK(TimerLib_SleepExit() > 0);
+
+        // 补偿后时间戳与真实时间的差在一个低速时钟周期以内
+        ts = TimerLib_GetTimestamp_tick();
+        offset = (int64_t)((sim.real - real0) - (ts - ts0));
+        SIM_CHECK(offset >= -SLOW_DIV && offset <= SLOW_DIV);
+        SIM_CHECK(TimerLib_GetInterval_ns(&h) / 1000 >= (asleep - SLOW_DIV) / 72);
+
+        // 唤醒后经过多次更新中断, 时间戳与真实时间的差必须保持不变
+        prev = ts;
+        for (i = 0; i < 20000; i++)
+        {
+            ts = TimerLib_GetTimestamp_tick();
+            SIM_CHECK(ts > prev);
+            SIM_CHECK((int64_t)((sim.real - real0) - (ts - ts0)) == offset);
+            prev = ts;
+        }
+    }
+    SIM_CHECK(TimerLib_GetSleepTotal_tick() > 20 * 100000);
+}
+
+int main(void)
+{
+    run(71, 10);
+    run(999, 3);
+    run(65535, 1);
+
+    printf("%s: %s\n", __FILE__, sim_failures ? "FAILED" : "ok");
+    return sim_failures != 0;
+}
@@ -0,0 +1,94 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file test_sync.c
+ * @brief 节点间时钟同步测试: 回环传输上设置不对称延迟与随机抖动,
+ *        测得偏移的误差不得超过两个方向延迟差的一半(加上抖动与轮询粒度)
+ */
+#include "TimerLib_Sync.h"
+#include "tim.h"
+
+#define SLAVE_OFFSET 123456789 // 从节点时钟领先主节点的tick数
+#define POLL_STEP 5            // 主循环每轮推进的tick数
+
+static uint64_t slave_clock(void)
+{
+    return TimerLib_GetTimestamp_tick() + SLAVE_OFFSET;
+}
+
+static void run(uint32_t lat_ms, uint32_t lat_sm, uint32_t jitter, uint32_t seed)
+{
+    TimerLib_SyncLoopback loop;
+    TimerLib_SyncMaster master;
+    TimerLib_SyncSlave slave;
+    int64_t expect = ((int64_t)lat_ms - (int64_t)lat_sm) / 2;
+    int64_t err_min = INT64_MAX, err_max = INT64_MIN, err_sum = 0;
+    // 每个时间戳最多晚于实际到达一个轮询步长(含读取推进的tick)
+    int64_t bound = (int64_t)(jitter + 1) / 2 + 2 * (POLL_STEP + 2);
+    uint32_t rounds = 0;
+
+    sim_reset(65536, 1);
+    TimerLib_GlobalInit(65535, 72000000);
+
+    TimerLib_SyncLoopback_Init(&loop, lat_ms, lat_sm);
+    TimerLib_SyncLoopback_SetJitter(&loop, jitter, seed);
+    TimerLib_SyncMaster_Init(&master, TimerLib_SyncLoopback_Transport(&loop, 0), NULL, 100);
+    TimerLib_SyncSlave_Init(&slave, TimerLib_SyncLoopback_Transport(&loop, 1), slave_clock);
+
+    while (rounds < 2000)
+    {
+        TimerLib_SyncMaster_Poll(&master);
+        if (TimerLib_SyncSlave_Poll(&slave))
+        {
+            int64_t err = slave.offset - SLAVE_OFFSET;
+
+            SIM_CHECK(err - expect <= bound && expect - err <= bound);
+            err_min = (err < err_min) ? err : err_min;
+            err_max = (err > err_max) ? err : err_max;
+            err_sum += err;
+            rounds++;
+        }
+        sim_advance(POLL_STEP);
+    }
+
+    printf("  latency %4u/%4u jitter %4u: error min %5lld max %5lld mean %7.1f (asymmetry/2 = %lld)\n", lat_ms, lat_sm,
+           jitter, (long long)err_min, (long long)err_max, (double)err_sum / rounds, (long long)expect);
+    SIM_CHECK(loop.link[0].dropped == 0 && loop.link[1].dropped == 0);
+
+    // 对称抖动下平均误差收敛到不对称量的一半
+    SIM_CHECK(err_sum / rounds - expect <= 2 * (POLL_STEP + 2) && expect - err_sum / rounds <= 2 * (POLL_STEP + 2));
+}
+
+int main(void)
+{
+    run(200, 200, 0, 1);
+    run(200, 600, 0, 1);
+    run(900, 300, 0, 1);
+    run(200, 200, 400, 1);
+    run(200, 600, 400, 2);
+    run(900, 300, 1000, 3);
+
+    printf("%s: %s\n", __FILE__, sim_failures ? "FAILED" : "ok");
+    return sim_failures != 0;
+}
@@ -0,0 +1,117 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+/**
+ * @file test_utc.c
+ * @brief UTC映射测试: 定时器晶振有已知的ppm偏差, 每秒加入一个带捕获抖动的秒脉冲参考对,
+ *        TimerLib_UTC_Now_ns 的误差在拟合窗口填满后必须收敛到界内
+ */
+#include "TimerLib_UTC.h"
+#include "tim.h"
+#include <stdlib.h>
+
+#define NOMINAL_FREQ 72000000
+#define UTC0 1700000000000000000ull // 首个秒脉冲的UTC(纳秒)
+#define SECONDS 60
+#define CAPTURE_JITTER 7 // 秒脉冲捕获抖动(±tick, 约±100ns)
+
+static double true_freq;
+
+// 模拟时刻对应的真实UTC
+static uint64_t true_utc(uint64_t tick)
+{
+    return UTC0 + (uint64_t)((double)tick * 1e9 / true_freq + 0.5);
+}
+
+static int64_t now_error(void)
+{
+    uint64_t utc = TimerLib_UTC_Now_ns();
+
+    return (int64_t)(utc - true_utc(sim_now()));
+}
+
+static void run(int32_t ppm, uint32_t seed)
+{
+    int64_t first_max = 0, settled_max = 0;
+    uint32_t s;
+
+    srand(seed);
+    true_freq = NOMINAL_FREQ * (1.0 + ppm * 1e-6);
+    sim_reset((uint64_t)1 << 32, 1);
+    TimerLib_GlobalInit(0xFFFFFFFF, NOMINAL_FREQ);
+    TimerLib_UTC_Init();
+    SIM_CHECK(!TimerLib_UTC_IsValid());
+
+    for (s = 0; s < SECONDS; s++)
+    {
+        uint64_t pps = (uint64_t)((double)s * true_freq + 0.5);
+        int64_t worst = 0;
+
+        // 秒脉冲时刻加入参考对, 捕获的tick带有抖动
+        sim_advance(pps - sim_now());
+        TimerLib_UTC_AddReference(sim_now() + (uint64_t)(rand() % (2 * CAPTURE_JITTER + 1)) - CAPTURE_JITTER,
+                                  UTC0 + (uint64_t)s * 1000000000);
+        SIM_CHECK(TimerLib_UTC_IsValid());
+
+        // 两个秒脉冲之间的任意时刻换算
+        for (int i = 0; i < 8; i++)
+        {
+            int64_t err;
+
+            sim_advance((uint64_t)rand() % (uint64_t)(true_freq / 9));
+            err = now_error();
+            err = (err < 0) ? -err : err;
+            worst = (err > worst) ? err : worst;
+        }
+
+        if (s == 0)
+        {
+            first_max = worst;
+        }
+        else if (s >= TIMERLIB_CLOCKMAP_WINDOW)
+        {
+            settled_max = (worst > settled_max) ? worst : settled_max;
+        }
+    }
+
+    printf("  %+4d ppm: first second max error %6lld ns, after %u references %4lld ns (error bound %u ns)\n", (int)ppm,
+           (long long)first_max, TIMERLIB_CLOCKMAP_WINDOW, (long long)settled_max, TimerLib_UTC_ErrorBound_ns());
+
+    // 只有一个参考对时按标称速率外推, 误差随ppm增长; 窗口填满后只剩捕获抖动的影响
+    SIM_CHECK(settled_max < 1000);
+    if (ppm != 0)
+    {
+        SIM_CHECK(first_max > settled_max);
+    }
+}
+
+int main(void)
+{
+    run(0, 1);
+    run(50, 2);
+    run(-120, 3);
+    run(20, 4);
+
+    printf("%s: %s\n", __FILE__, sim_failures ? "FAILED" : "ok");
+    return sim_failures != 0;
+}
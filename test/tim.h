@@ -0,0 +1,107 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024 [C17Dev562]
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* tim.h */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+/*
+ * 主机测试用的定时器模拟, 代替目标板上的CubeMX生成的tim.h
+ *
+ * 计数器每被读取一次前进 step 个tick(可由 slow_div 改为每N次读取前进1个tick,
+ * 模拟计数时钟慢于内核的异步定时器)。每 rep 次回绕产生一次更新事件, 中断在
+ * PRIMASK置位期间挂起, 解除屏蔽时执行, 与Cortex-M的行为一致。
+ */
+
+typedef struct {
+    uint64_t ticks;       // 计数器自启动以来的总tick数(只在running时前进)
+    uint64_t real;        // 真实时间(tick), 定时器停止时同样前进
+    uint64_t period;      // 溢出周期(ARR+1)
+    uint32_t step;        // 每次读取前进的tick数
+    uint32_t slow_div;    // 非0时每slow_div次读取前进1个tick, 忽略step
+    uint32_t rep;         // 每rep次回绕产生一次更新中断(RCR+1)
+    uint32_t rep_phase;   // 自上次更新事件以来的回绕数(硬件重复计数器状态)
+    bool irq_enabled;     // 是否产生更新中断
+    bool running;         // 定时器是否在计数
+    uint32_t primask;     // 中断屏蔽状态
+    uint32_t pending;     // 挂起的更新中断数
+    uint32_t torn_every;  // 非0时每torn_every次读取返回一次撕裂的数值
+    uint64_t reads;       // 读取次数
+    uint64_t torn;        // 已注入的撕裂读数
+    uint64_t irqs;        // 已执行的更新中断数
+    void (*on_irq)(void); // 非0时在每次更新中断中、TimerLib处理之后调用(模拟用户中断服务)
+    uint32_t host_hz;     // 非0时计数器按主机单调时钟以该频率前进, 忽略step(测量空循环等真实耗时)
+    uint64_t host_last;   // 上次读取时的主机时间(纳秒)
+    uint64_t host_rem;    // 换算成tick后不足一个tick的余量(tick*1e9)
+} SimTimer;
+
+extern SimTimer sim;
+
+/**
+ * @brief 复位模拟定时器
+ * @param period 溢出周期(ARR+1)
+ * @param step 每次读取前进的tick数
+ */
+void sim_reset(uint64_t period, uint32_t step);
+
+/**
+ * @brief 让时间前进, 定时器运行时计数器同样前进并产生回绕
+ */
+void sim_advance(uint64_t ticks);
+
+/**
+ * @brief 当前真实计数器值对应的tick总数(测试期望值)
+ */
+uint64_t sim_now(void);
+
+/**
+ * @brief 改为按主机单调时钟计数, 频率为hz; 0表示恢复按读取次数前进
+ */
+void sim_use_host_clock(uint32_t hz);
+
+uint32_t sim_read(void);
+void sim_set_counter(uint32_t cnt);
+void sim_set_primask(uint32_t mask);
+
+/**
+ * @brief 检查条件, 失败时打印位置并计数
+ */
+extern int sim_failures;
+#define SIM_CHECK(cond)                                                      \
+    do                                                                       \
+    {                                                                        \
+        if (!(cond) && sim_failures++ < 10)                                  \
+        {                                                                    \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+        }                                                                    \
+    } while (0)
+
+#define TIM1 0
+#define LL_TIM_GetCounter(tim) ((void)(tim), sim_read())
+#define LL_TIM_SetCounter(tim, cnt) ((void)(tim), sim_set_counter(cnt))
+#define __get_PRIMASK() (sim.primask)
+#define __set_PRIMASK(mask) sim_set_primask(mask)
+#define __disable_irq() (sim.primask = 1)